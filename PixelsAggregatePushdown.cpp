@@ -0,0 +1,470 @@
+//
+// Created by pixels on 10/18/26.
+//
+
+#include "PixelsAggregatePushdown.hpp"
+#include "PixelsReadBindData.hpp"
+#include "PixelsScanFunction.hpp"
+#include "TypeDescription.h"
+#include "utils/ConfigFactory.h"
+#include "duckdb/function/function_binder.hpp"
+#include "duckdb/optimizer/optimizer.hpp"
+#include "duckdb/planner/binder.hpp"
+#include "duckdb/planner/operator/logical_aggregate.hpp"
+#include "duckdb/planner/operator/logical_dummy_scan.hpp"
+#include "duckdb/planner/operator/logical_filter.hpp"
+#include "duckdb/planner/operator/logical_get.hpp"
+#include "duckdb/planner/operator/logical_projection.hpp"
+#include "duckdb/planner/expression/bound_aggregate_expression.hpp"
+#include "duckdb/planner/expression/bound_cast_expression.hpp"
+#include "duckdb/planner/expression/bound_columnref_expression.hpp"
+#include "duckdb/planner/expression/bound_constant_expression.hpp"
+#include "duckdb/planner/expression/bound_operator_expression.hpp"
+
+namespace duckdb {
+
+enum class PixelsAggregateKind { COUNT_STAR, COUNT, MIN, MAX, SUM };
+
+struct PixelsAggregateTarget {
+	PixelsAggregateKind kind;
+	//! column id in the file schema, -1 for count(*)
+	int columnId;
+	TypeDescription::Category category;
+	LogicalType returnType;
+};
+
+//! The result of one aggregate over the files and row groups answered by statistics
+struct PixelsAggregatePartial {
+	idx_t count = 0;
+	hugeint_t sum = 0;
+	bool hasSum = false;
+	Value min;
+	Value max;
+};
+
+static bool StatisticBound(const pixels::proto::ColumnStatistic &stat, TypeDescription::Category category,
+                           bool minimum, Value &result) {
+	switch (category) {
+	case TypeDescription::SHORT:
+	case TypeDescription::INT:
+	case TypeDescription::LONG: {
+		if (!stat.has_intstatistics()) {
+			return false;
+		}
+		auto &intStat = stat.intstatistics();
+		if (minimum ? !intStat.has_minimum() : !intStat.has_maximum()) {
+			return false;
+		}
+		int64_t bound = minimum ? intStat.minimum() : intStat.maximum();
+		result = category == TypeDescription::LONG ? Value::BIGINT(bound) : Value::INTEGER((int32_t)bound);
+		return true;
+	}
+	case TypeDescription::DATE: {
+		if (!stat.has_datestatistics()) {
+			return false;
+		}
+		auto &dateStat = stat.datestatistics();
+		if (minimum ? !dateStat.has_minimum() : !dateStat.has_maximum()) {
+			return false;
+		}
+		result = Value::DATE(date_t(minimum ? dateStat.minimum() : dateStat.maximum()));
+		return true;
+	}
+	case TypeDescription::TIMESTAMP: {
+		if (!stat.has_timestampstatistics()) {
+			return false;
+		}
+		auto &tsStat = stat.timestampstatistics();
+		if (minimum ? !tsStat.has_minimum() : !tsStat.has_maximum()) {
+			return false;
+		}
+		result = Value::TIMESTAMP(timestamp_t(minimum ? tsStat.minimum() : tsStat.maximum()));
+		return true;
+	}
+	case TypeDescription::STRING:
+	case TypeDescription::VARCHAR:
+	case TypeDescription::CHAR: {
+		if (!stat.has_stringstatistics()) {
+			return false;
+		}
+		auto &strStat = stat.stringstatistics();
+		if (minimum ? !strStat.has_minimum() : !strStat.has_maximum()) {
+			return false;
+		}
+		result = Value(minimum ? strStat.minimum() : strStat.maximum());
+		return true;
+	}
+	default:
+		// decimal statistics are not written in a form we can trust yet
+		return false;
+	}
+}
+
+static bool IsConclusive(const PixelsAggregateTarget &target, const pixels::proto::ColumnStatistic *stat) {
+	if (target.kind == PixelsAggregateKind::COUNT_STAR) {
+		return true;
+	}
+	// numberOfValues counts the null values as well, without it nothing else can be trusted
+	if (stat == nullptr || !stat->has_numberofvalues()) {
+		return false;
+	}
+	if (stat->numberofvalues() == 0) {
+		return true;
+	}
+	if (target.kind == PixelsAggregateKind::COUNT) {
+		// the non-null values are only known when there is no null value
+		return stat->has_hasnull() && !stat->hasnull();
+	}
+	Value bound;
+	switch (target.kind) {
+	case PixelsAggregateKind::MIN:
+		return StatisticBound(*stat, target.category, true, bound);
+	case PixelsAggregateKind::MAX:
+		return StatisticBound(*stat, target.category, false, bound);
+	case PixelsAggregateKind::SUM:
+		return stat->has_intstatistics() && stat->intstatistics().has_sum();
+	default:
+		return false;
+	}
+}
+
+static void Accumulate(const PixelsAggregateTarget &target, const pixels::proto::ColumnStatistic *stat,
+                       uint64_t numberOfRows, PixelsAggregatePartial &partial) {
+	if (target.kind == PixelsAggregateKind::COUNT_STAR) {
+		partial.count += numberOfRows;
+		return;
+	}
+	if (stat->numberofvalues() == 0) {
+		return;
+	}
+	Value bound;
+	switch (target.kind) {
+	case PixelsAggregateKind::COUNT:
+		partial.count += stat->numberofvalues();
+		break;
+	case PixelsAggregateKind::MIN:
+		StatisticBound(*stat, target.category, true, bound);
+		if (partial.min.IsNull() || bound < partial.min) {
+			partial.min = bound;
+		}
+		break;
+	case PixelsAggregateKind::MAX:
+		StatisticBound(*stat, target.category, false, bound);
+		if (partial.max.IsNull() || bound > partial.max) {
+			partial.max = bound;
+		}
+		break;
+	case PixelsAggregateKind::SUM:
+		partial.sum += hugeint_t(stat->intstatistics().sum());
+		partial.hasSum = true;
+		break;
+	default:
+		break;
+	}
+}
+
+static Value PartialValue(const PixelsAggregateTarget &target, const PixelsAggregatePartial &partial) {
+	switch (target.kind) {
+	case PixelsAggregateKind::COUNT_STAR:
+	case PixelsAggregateKind::COUNT:
+		return Value::BIGINT((int64_t)partial.count).DefaultCastAs(target.returnType);
+	case PixelsAggregateKind::MIN:
+		return partial.min.DefaultCastAs(target.returnType);
+	case PixelsAggregateKind::MAX:
+		return partial.max.DefaultCastAs(target.returnType);
+	case PixelsAggregateKind::SUM:
+		return partial.hasSum ? Value::HUGEINT(partial.sum).DefaultCastAs(target.returnType)
+		                      : Value(target.returnType);
+	default:
+		throw InternalException("PixelsAggregatePushdown: unknown aggregate kind");
+	}
+}
+
+static bool GetAggregateTarget(BoundAggregateExpression &aggr, LogicalGet &get, const PixelsReadBindData &bindData,
+                               PixelsAggregateTarget &target) {
+	auto &name = aggr.function.name;
+	if (name == "count_star") {
+		target.kind = PixelsAggregateKind::COUNT_STAR;
+	} else if (name == "count") {
+		target.kind = PixelsAggregateKind::COUNT;
+	} else if (name == "min") {
+		target.kind = PixelsAggregateKind::MIN;
+	} else if (name == "max") {
+		target.kind = PixelsAggregateKind::MAX;
+	} else if (name == "sum") {
+		target.kind = PixelsAggregateKind::SUM;
+	} else {
+		return false;
+	}
+	if (aggr.filter || aggr.order_bys) {
+		return false;
+	}
+	if (aggr.IsDistinct() && target.kind != PixelsAggregateKind::MIN && target.kind != PixelsAggregateKind::MAX) {
+		return false;
+	}
+	target.returnType = aggr.return_type;
+	target.columnId = -1;
+	if (target.kind == PixelsAggregateKind::COUNT_STAR) {
+		return aggr.children.empty();
+	}
+	if (aggr.children.size() != 1 || aggr.children[0]->type != ExpressionType::BOUND_COLUMN_REF) {
+		return false;
+	}
+	auto &colref = aggr.children[0]->Cast<BoundColumnRefExpression>();
+	if (colref.binding.table_index != get.table_index || colref.binding.column_index >= get.column_ids.size()) {
+		return false;
+	}
+	auto columnId = get.column_ids[colref.binding.column_index];
+	if (IsRowIdColumnId(columnId)) {
+		return false;
+	}
+	target.columnId = (int)columnId;
+	target.category = bindData.fileSchema->getChildren().at(columnId)->getCategory();
+	if (target.kind == PixelsAggregateKind::SUM && target.category != TypeDescription::SHORT &&
+	    target.category != TypeDescription::INT && target.category != TypeDescription::LONG) {
+		return false;
+	}
+	return true;
+}
+
+static const pixels::proto::ColumnStatistic *
+FindColumnStat(const ::google::protobuf::RepeatedPtrField<pixels::proto::ColumnStatistic> &stats, int columnId) {
+	if (columnId < 0 || columnId >= stats.size()) {
+		return nullptr;
+	}
+	return &stats.Get(columnId);
+}
+
+static unique_ptr<Expression> CombineWithScan(ClientContext &context, const PixelsAggregateTarget &target,
+                                              const Value &partial, unique_ptr<Expression> scanned) {
+	if (partial.IsNull()) {
+		return scanned;
+	}
+	vector<unique_ptr<Expression>> children;
+	children.push_back(make_uniq<BoundConstantExpression>(partial));
+	string function;
+	bool isOperator = false;
+	switch (target.kind) {
+	case PixelsAggregateKind::MIN:
+		function = "least";
+		children.push_back(std::move(scanned));
+		break;
+	case PixelsAggregateKind::MAX:
+		function = "greatest";
+		children.push_back(std::move(scanned));
+		break;
+	case PixelsAggregateKind::SUM: {
+		// the sum over the scanned row groups is NULL if they only contain nulls
+		auto coalesce = make_uniq<BoundOperatorExpression>(ExpressionType::OPERATOR_COALESCE, target.returnType);
+		coalesce->children.push_back(std::move(scanned));
+		coalesce->children.push_back(make_uniq<BoundConstantExpression>(Value::INTEGER(0).DefaultCastAs(target.returnType)));
+		children.push_back(std::move(coalesce));
+		function = "+";
+		isOperator = true;
+		break;
+	}
+	default:
+		children.push_back(std::move(scanned));
+		function = "+";
+		isOperator = true;
+		break;
+	}
+	ErrorData error;
+	FunctionBinder binder(context);
+	auto combined = binder.BindScalarFunction(DEFAULT_SCHEMA, function, std::move(children), error, isOperator);
+	if (!combined) {
+		return nullptr;
+	}
+	return BoundCastExpression::AddCastToType(context, std::move(combined), target.returnType);
+}
+
+OptimizerExtension PixelsAggregatePushdown::GetOptimizerExtension() {
+	OptimizerExtension extension;
+	extension.optimize_function = PixelsAggregatePushdown::Optimize;
+	return extension;
+}
+
+void PixelsAggregatePushdown::Optimize(OptimizerExtensionInput &input, unique_ptr<LogicalOperator> &plan) {
+	if (!ConfigFactory::Instance().boolCheckProperty("pixel.enable.aggregate.pushdown")) {
+		return;
+	}
+	if (TryRewrite(input, plan)) {
+		return;
+	}
+	for (auto &child : plan->children) {
+		Optimize(input, child);
+	}
+}
+
+bool PixelsAggregatePushdown::TryRewrite(OptimizerExtensionInput &input, unique_ptr<LogicalOperator> &op) {
+	if (op->type != LogicalOperatorType::LOGICAL_AGGREGATE_AND_GROUP_BY || op->children.size() != 1) {
+		return false;
+	}
+	// the aggregate reads the scan directly, or through the filter of a WHERE clause
+	auto *child = op->children[0].get();
+	LogicalFilter *filter = nullptr;
+	if (child->type == LogicalOperatorType::LOGICAL_FILTER && child->children.size() == 1) {
+		filter = &child->Cast<LogicalFilter>();
+		child = child->children[0].get();
+	}
+	if (child->type != LogicalOperatorType::LOGICAL_GET) {
+		return false;
+	}
+	auto &aggregate = op->Cast<LogicalAggregate>();
+	auto &get = child->Cast<LogicalGet>();
+	if (!aggregate.groups.empty() || aggregate.grouping_sets.size() > 1 || get.function.name != "pixels_scan" ||
+	    !get.table_filters.filters.empty() || !get.bind_data) {
+		return false;
+	}
+	auto &bindData = get.bind_data->Cast<PixelsReadBindData>();
+
+	// the statistics tell which rows satisfy the filter only if every expression of the filter
+	// is a pruning filter of the scan. They are transformed again rather than taken from
+	// bindData.pruningFilters, so that a missing one can't make a file look fully matched
+	vector<unique_ptr<TableFilter>> pruningFilters;
+	unordered_map<column_t, vector<TableFilter *>> columnFilters;
+	if (filter != nullptr) {
+		for (auto &expression : filter->expressions) {
+			column_t columnId;
+			auto pruningFilter = PixelsScanFunction::TransformPruningFilter(get, *expression, columnId);
+			if (pruningFilter == nullptr) {
+				return false;
+			}
+			columnFilters[columnId].emplace_back(pruningFilter.get());
+			pruningFilters.emplace_back(std::move(pruningFilter));
+		}
+	}
+	vector<LogicalType> types;
+	PixelsScanFunction::TransformDuckdbType(bindData.fileSchema, types);
+	// FILTER_ALWAYS_TRUE if there is no filter
+	auto checkFilters = [&](const ::google::protobuf::RepeatedPtrField<pixels::proto::ColumnStatistic> &stats) {
+		return PixelsScanFunction::CheckColumnFilters(columnFilters, stats, types);
+	};
+
+	vector<PixelsAggregateTarget> targets;
+	for (auto &expr : aggregate.expressions) {
+		if (expr->GetExpressionClass() != ExpressionClass::BOUND_AGGREGATE) {
+			return false;
+		}
+		PixelsAggregateTarget target;
+		if (!GetAggregateTarget(expr->Cast<BoundAggregateExpression>(), get, bindData, target)) {
+			return false;
+		}
+		targets.emplace_back(std::move(target));
+	}
+	if (targets.empty()) {
+		return false;
+	}
+
+	// answer each file from its column statistics, or each row group from its row group statistics.
+	// With a filter, only the files and row groups whose rows all satisfy it are answered, and
+	// those without any row that satisfies it are neither answered nor scanned
+	vector<PixelsAggregatePartial> partials(targets.size());
+	vector<string> scannedFiles;
+	vector<std::shared_ptr<pixels::proto::FileTail>> scannedFileTails;
+	vector<idx_t> scannedFileRowCounts;
+	unordered_map<string, std::vector<bool>> rowGroupSelection;
+	for (idx_t fileId = 0; fileId < bindData.files.size(); fileId++) {
+		auto &file = bindData.files.at(fileId);
+		auto &fileTail = bindData.fileTails.at(fileId);
+		auto &footer = fileTail->footer();
+		auto &columnStats = footer.columnstats();
+		auto fileFilter = checkFilters(columnStats);
+		if (fileFilter == FilterPropagateResult::FILTER_ALWAYS_FALSE) {
+			continue;
+		}
+		bool fileConclusive = fileFilter == FilterPropagateResult::FILTER_ALWAYS_TRUE;
+		for (auto &target : targets) {
+			fileConclusive = fileConclusive && IsConclusive(target, FindColumnStat(columnStats, target.columnId));
+		}
+		if (fileConclusive) {
+			for (idx_t i = 0; i < targets.size(); i++) {
+				Accumulate(targets[i], FindColumnStat(columnStats, targets[i].columnId),
+				           fileTail->postscript().numberofrows(), partials[i]);
+			}
+			continue;
+		}
+
+		auto &rowGroupInfos = footer.rowgroupinfos();
+		auto &rowGroupStats = footer.rowgroupstats();
+		std::vector<bool> selection(rowGroupInfos.size(), false);
+		bool scanWholeFile = true;
+		bool scanAnyRowGroup = false;
+		for (int rgId = 0; rgId < rowGroupInfos.size(); rgId++) {
+			bool rowGroupConclusive = rgId < rowGroupStats.size();
+			if (rowGroupConclusive && fileFilter != FilterPropagateResult::FILTER_ALWAYS_TRUE) {
+				auto rowGroupFilter = checkFilters(rowGroupStats.Get(rgId).columnchunkstats());
+				if (rowGroupFilter == FilterPropagateResult::FILTER_ALWAYS_FALSE) {
+					scanWholeFile = false;
+					continue;
+				}
+				rowGroupConclusive = rowGroupFilter == FilterPropagateResult::FILTER_ALWAYS_TRUE;
+			}
+			for (auto &target : targets) {
+				if (!rowGroupConclusive) {
+					break;
+				}
+				rowGroupConclusive = IsConclusive(
+				    target, FindColumnStat(rowGroupStats.Get(rgId).columnchunkstats(), target.columnId));
+			}
+			if (!rowGroupConclusive) {
+				selection[rgId] = true;
+				scanAnyRowGroup = true;
+				continue;
+			}
+			scanWholeFile = false;
+			for (idx_t i = 0; i < targets.size(); i++) {
+				Accumulate(targets[i], FindColumnStat(rowGroupStats.Get(rgId).columnchunkstats(), targets[i].columnId),
+				           rowGroupInfos.Get(rgId).numberofrows(), partials[i]);
+			}
+		}
+		if (scanAnyRowGroup) {
+			scannedFiles.emplace_back(file);
+			scannedFileTails.emplace_back(fileTail);
+			scannedFileRowCounts.emplace_back(bindData.fileRowCounts.at(fileId));
+			if (!scanWholeFile) {
+				rowGroupSelection[file] = std::move(selection);
+			}
+		}
+	}
+	if (scannedFiles.size() == bindData.files.size() && rowGroupSelection.empty()) {
+		// statistics do not help, keep the plan as it is
+		return false;
+	}
+
+	auto &context = input.context;
+	auto &binder = input.optimizer.binder;
+	vector<unique_ptr<Expression>> results;
+	if (scannedFiles.empty()) {
+		for (idx_t i = 0; i < targets.size(); i++) {
+			results.push_back(make_uniq<BoundConstantExpression>(PartialValue(targets[i], partials[i])));
+		}
+		auto projection = make_uniq<LogicalProjection>(aggregate.aggregate_index, std::move(results));
+		projection->children.push_back(make_uniq<LogicalDummyScan>(binder.GenerateTableIndex()));
+		op = std::move(projection);
+		return true;
+	}
+
+	// scan the remaining row groups and combine their aggregates with the statistics
+	idx_t scanAggregateIndex = binder.GenerateTableIndex();
+	for (idx_t i = 0; i < targets.size(); i++) {
+		auto scanned = make_uniq<BoundColumnRefExpression>(aggregate.expressions[i]->return_type,
+		                                                   ColumnBinding(scanAggregateIndex, i));
+		auto combined = CombineWithScan(context, targets[i], PartialValue(targets[i], partials[i]), std::move(scanned));
+		if (!combined) {
+			return false;
+		}
+		results.push_back(std::move(combined));
+	}
+	bindData.files = std::move(scannedFiles);
+	bindData.fileTails = std::move(scannedFileTails);
+	bindData.fileRowCounts = std::move(scannedFileRowCounts);
+	bindData.rowGroupSelection = std::move(rowGroupSelection);
+	auto projection = make_uniq<LogicalProjection>(aggregate.aggregate_index, std::move(results));
+	aggregate.aggregate_index = scanAggregateIndex;
+	projection->children.push_back(std::move(op));
+	op = std::move(projection);
+	return true;
+}
+
+} // namespace duckdb
@@ -5,6 +5,14 @@
 #include "PixelsScanFunction.hpp"
 #include "physical/StorageArrayScheduler.h"
 #include "profiler/CountProfiler.h"
+#include "utils/NumaUtil.h"
+#include "duckdb/storage/buffer_manager.hpp"
+#include "duckdb/planner/expression/bound_columnref_expression.hpp"
+#include "duckdb/planner/expression/bound_comparison_expression.hpp"
+#include "duckdb/planner/expression/bound_constant_expression.hpp"
+#include "duckdb/planner/expression/bound_operator_expression.hpp"
+#include "duckdb/planner/filter/constant_filter.hpp"
+#include "duckdb/planner/filter/null_filter.hpp"
 
 namespace duckdb {
 
@@ -29,8 +37,91 @@ static double PixelsProgress(ClientContext &context, const FunctionData *bind_da
 
 static unique_ptr<NodeStatistics> PixelsCardinality(ClientContext &context, const FunctionData *bind_data) {
 	auto &data = (PixelsReadBindData &)*bind_data;
+	idx_t numberOfRows = 0;
+	for (auto fileRows : data.fileRowCounts) {
+		numberOfRows += fileRows;
+	}
+	return make_uniq<NodeStatistics>(numberOfRows, numberOfRows);
+}
+
+static unique_ptr<BaseStatistics> PixelsStatistics(ClientContext &context, const FunctionData *bind_data,
+                                                   column_t column_index) {
+	auto &data = (PixelsReadBindData &)*bind_data;
+	if (IsRowIdColumnId(column_index) || column_index >= data.columnStatistics.size() ||
+	    data.columnStatistics.at(column_index) == nullptr) {
+		return nullptr;
+	}
+	return data.columnStatistics.at(column_index)->ToUnique();
+}
 
-	return make_uniq<NodeStatistics>(data.initialPixelsReader->getNumberOfRows() * data.files.size());
+static bool GetFileColumnId(const LogicalGet &get, const Expression &expr, column_t &column_id) {
+	if (expr.GetExpressionClass() != ExpressionClass::BOUND_COLUMN_REF) {
+		return false;
+	}
+	auto &colref = expr.Cast<BoundColumnRefExpression>();
+	if (colref.depth > 0 || colref.binding.table_index != get.table_index ||
+	    colref.binding.column_index >= get.column_ids.size()) {
+		return false;
+	}
+	column_id = get.column_ids[colref.binding.column_index];
+	return !IsRowIdColumnId(column_id);
+}
+
+unique_ptr<TableFilter> PixelsScanFunction::TransformPruningFilter(const LogicalGet &get, const Expression &filter,
+                                                                  column_t &column_id) {
+	if (filter.GetExpressionClass() == ExpressionClass::BOUND_COMPARISON) {
+		auto &comparison = filter.Cast<BoundComparisonExpression>();
+		auto comparisonType = comparison.type;
+		switch (comparisonType) {
+			case ExpressionType::COMPARE_EQUAL:
+			case ExpressionType::COMPARE_LESSTHAN:
+			case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+			case ExpressionType::COMPARE_GREATERTHAN:
+			case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+				break;
+			default:
+				return nullptr;
+		}
+		const Expression *column = comparison.left.get();
+		const Expression *constant = comparison.right.get();
+		if (constant->GetExpressionClass() != ExpressionClass::BOUND_CONSTANT) {
+			std::swap(column, constant);
+			comparisonType = FlipComparisonExpression(comparisonType);
+		}
+		if (constant->GetExpressionClass() != ExpressionClass::BOUND_CONSTANT ||
+		    !GetFileColumnId(get, *column, column_id)) {
+			return nullptr;
+		}
+		auto &value = constant->Cast<BoundConstantExpression>().value;
+		if (value.IsNull() || value.type() != column->return_type) {
+			return nullptr;
+		}
+		return make_uniq<ConstantFilter>(comparisonType, value);
+	} else if (filter.GetExpressionType() == ExpressionType::OPERATOR_IS_NULL ||
+	           filter.GetExpressionType() == ExpressionType::OPERATOR_IS_NOT_NULL) {
+		auto &op = filter.Cast<BoundOperatorExpression>();
+		if (op.children.size() != 1 || !GetFileColumnId(get, *op.children[0], column_id)) {
+			return nullptr;
+		}
+		if (filter.GetExpressionType() == ExpressionType::OPERATOR_IS_NULL) {
+			return make_uniq<IsNullFilter>();
+		}
+		return make_uniq<IsNotNullFilter>();
+	}
+	return nullptr;
+}
+
+static void PixelsScanPushdownComplexFilter(ClientContext &context, LogicalGet &get, FunctionData *bind_data_p,
+                                            vector<unique_ptr<Expression>> &filters) {
+	auto &bind_data = (PixelsReadBindData &)*bind_data_p;
+	// only collect what can prune files, the expressions stay in the plan
+	for (auto &filter : filters) {
+		column_t column_id;
+		auto pruningFilter = PixelsScanFunction::TransformPruningFilter(get, *filter, column_id);
+		if (pruningFilter != nullptr) {
+			bind_data.pruningFilters.PushFilter(column_id, std::move(pruningFilter));
+		}
+	}
 }
 
 TableFunctionSet PixelsScanFunction::GetFunctionSet() {
@@ -43,6 +134,8 @@ TableFunctionSet PixelsScanFunction::GetFunctionSet() {
     MultiFileReader::AddParameters(table_function);
 	table_function.get_batch_index = PixelsScanGetBatchIndex;
 	table_function.cardinality = PixelsCardinality;
+	table_function.statistics = PixelsStatistics;
+	table_function.pushdown_complex_filter = PixelsScanPushdownComplexFilter;
 	table_function.table_scan_progress = PixelsProgress;
 	// TODO: maybe we need other code here later. Refer parquet-extension.cpp
     return MultiFileReader::CreateFunctionSet(table_function);
@@ -139,10 +232,21 @@ unique_ptr<FunctionData> PixelsScanFunction::PixelsScanBind(
     if (files.empty()) {
         throw InvalidArgumentException("The number of pxl file should be positive. ");
     }
-    // sort the pxl file by file name, so that all SSD arrays can be fully utilized
-    sort(files.begin(), files.end(), compare_file_name());
+    // sort the pxl file by file name, so that all SSD arrays can be fully utilized.
+    // The numbers are parsed once, not in every comparison.
+    vector<std::pair<int, string>> numberedFiles;
+    numberedFiles.reserve(files.size());
+    for (auto &file : files) {
+        numberedFiles.emplace_back(compare_file_name::filename2num(file), std::move(file));
+    }
+    std::stable_sort(numberedFiles.begin(), numberedFiles.end(),
+                     [](const std::pair<int, string> &a, const std::pair<int, string> &b) { return a.first < b.first; });
+    for (idx_t i = 0; i < files.size(); i++) {
+        files.at(i) = std::move(numberedFiles.at(i).second);
+    }
 
-	auto footerCache = std::make_shared<PixelsFooterCache>();
+	auto footerCache = PixelsFooterCache::Instance();
+	auto fileTails = LoadManifestFileTails(files, footerCache);
 	auto builder = std::make_shared<PixelsReaderBuilder>();
 
 	std::shared_ptr<::Storage> storage = StorageFactory::getInstance()->getStorage(::Storage::file);
@@ -159,10 +263,184 @@ unique_ptr<FunctionData> PixelsScanFunction::PixelsScanBind(
 	result->initialPixelsReader = pixelsReader;
 	result->fileSchema = fileSchema;
 	result->files = files;
+	result->footerCache = footerCache;
+	result->fileTails = std::move(fileTails);
+	CollectFileStatistics(*result, return_types);
 
 	return std::move(result);
 }
 
+vector<std::shared_ptr<pixels::proto::FileTail>>
+PixelsScanFunction::LoadManifestFileTails(const vector<string> &files,
+                                          const std::shared_ptr<PixelsFooterCache> &footerCache) {
+	vector<std::shared_ptr<pixels::proto::FileTail>> fileTails(files.size());
+	if (!ConfigFactory::Instance().boolCheckProperty("pixel.enable.manifest")) {
+		return fileTails;
+	}
+	unordered_map<string, std::shared_ptr<PixelsManifest>> manifests;
+	for (idx_t i = 0; i < files.size(); i++) {
+		auto absolutePath = std::filesystem::absolute(files.at(i)).lexically_normal().string();
+		auto directory = absolutePath.substr(0, absolutePath.find_last_of('/') + 1);
+		auto manifest = manifests.find(directory);
+		if (manifest == manifests.end()) {
+			manifest = manifests.emplace(directory, PixelsManifest::open(directory)).first;
+		}
+		if (manifest->second == nullptr) {
+			continue;
+		}
+		auto entry = manifest->second->find(absolutePath);
+		if (entry == nullptr) {
+			continue;
+		}
+		fileTails.at(i) = std::make_shared<pixels::proto::FileTail>(entry->filetail());
+		// let the readers opened by the scan skip reading the tail as well
+		footerCache->putFileTail(
+		    PixelsFooterCache::fileId(absolutePath, entry->modificationtime(), entry->filesize()), fileTails.at(i));
+	}
+	return fileTails;
+}
+
+void PixelsScanFunction::CollectFileStatistics(PixelsReadBindData &bind_data, const vector<LogicalType> &return_types) {
+	std::shared_ptr<::Storage> storage = StorageFactory::getInstance()->getStorage(::Storage::file);
+	auto columnNum = return_types.size();
+	// a column keeps statistics only if every file has usable statistics for it
+	vector<bool> statisticsValid(columnNum, true);
+	vector<uint64_t> numberOfValues(columnNum, 0);
+	bind_data.columnStatistics.clear();
+	bind_data.columnStatistics.resize(columnNum);
+	bind_data.fileRowCounts.clear();
+	bind_data.fileRowCounts.reserve(bind_data.files.size());
+	for (idx_t fileId = 0; fileId < bind_data.files.size(); fileId++) {
+		auto &fileTail = bind_data.fileTails.at(fileId);
+		if (fileTail == nullptr) {
+			// not in a manifest, read the tail from the file
+			std::shared_ptr<PixelsReader> reader = bind_data.initialPixelsReader;
+			if (fileId > 0) {
+				auto builder = std::make_shared<PixelsReaderBuilder>();
+				reader = builder->setPath(bind_data.files.at(fileId))
+				             ->setStorage(storage)
+				             ->setPixelsFooterCache(bind_data.footerCache)
+				             ->build();
+			}
+			fileTail = reader->getFileTail();
+			if (fileId > 0) {
+				reader->close();
+			}
+		}
+		bind_data.fileRowCounts.emplace_back(fileTail->postscript().numberofrows());
+		auto &columnStats = fileTail->footer().columnstats();
+		for (idx_t colId = 0; colId < columnNum; colId++) {
+			if (!statisticsValid.at(colId)) {
+				continue;
+			}
+			unique_ptr<BaseStatistics> fileStats;
+			if ((int)colId < columnStats.size()) {
+				fileStats = TransformDuckdbStatistics(columnStats.Get((int)colId), return_types.at(colId));
+			}
+			if (fileStats == nullptr) {
+				statisticsValid.at(colId) = false;
+				bind_data.columnStatistics.at(colId) = nullptr;
+				continue;
+			}
+			numberOfValues.at(colId) += columnStats.Get((int)colId).numberofvalues();
+			if (bind_data.columnStatistics.at(colId) == nullptr) {
+				bind_data.columnStatistics.at(colId) = std::move(fileStats);
+			} else {
+				bind_data.columnStatistics.at(colId)->Merge(*fileStats);
+			}
+		}
+	}
+	// there is no distinct count in the footer, so estimate it by the number of values, bounded by the
+	// value range for integral types
+	for (idx_t colId = 0; colId < columnNum; colId++) {
+		auto &stats = bind_data.columnStatistics.at(colId);
+		if (stats == nullptr) {
+			continue;
+		}
+		idx_t distinct = numberOfValues.at(colId);
+		auto &type = return_types.at(colId);
+		if ((type.id() == LogicalTypeId::INTEGER || type.id() == LogicalTypeId::BIGINT ||
+		     type.id() == LogicalTypeId::DATE) &&
+		    NumericStats::HasMinMax(*stats)) {
+			// there is no cast from DATE to an integer, so the days are read as they are
+			auto min = type.id() == LogicalTypeId::DATE ? hugeint_t(NumericStats::Min(*stats).GetValue<date_t>().days)
+			                                            : hugeint_t(NumericStats::Min(*stats).GetValue<int64_t>());
+			auto max = type.id() == LogicalTypeId::DATE ? hugeint_t(NumericStats::Max(*stats).GetValue<date_t>().days)
+			                                            : hugeint_t(NumericStats::Max(*stats).GetValue<int64_t>());
+			hugeint_t range = max - min + hugeint_t(1);
+			// the range is below distinct here, so it fits in its low 64 bits
+			if (range > hugeint_t(0) && range < hugeint_t(distinct)) {
+				distinct = (idx_t)range.lower;
+			}
+		}
+		stats->SetDistinctCount(distinct);
+	}
+}
+
+unique_ptr<BaseStatistics> PixelsScanFunction::TransformDuckdbStatistics(const pixels::proto::ColumnStatistic &stat,
+                                                                        const LogicalType &type) {
+	if (!stat.has_numberofvalues()) {
+		return nullptr;
+	}
+	auto result = BaseStatistics::CreateEmpty(type);
+	if (stat.numberofvalues() > 0) {
+		result.SetHasNoNull();
+	}
+	if (!stat.has_hasnull() || stat.hasnull()) {
+		result.SetHasNull();
+	}
+	if (stat.numberofvalues() == 0) {
+		// only nulls (or no rows at all), the empty min/max is what DuckDB expects here
+		return result.ToUnique();
+	}
+	switch (type.id()) {
+		case LogicalTypeId::INTEGER:
+		case LogicalTypeId::BIGINT: {
+			if (!stat.has_intstatistics() || !stat.intstatistics().has_minimum() ||
+			    !stat.intstatistics().has_maximum()) {
+				return nullptr;
+			}
+			NumericStats::SetMin(result, Value::BIGINT(stat.intstatistics().minimum()).DefaultCastAs(type));
+			NumericStats::SetMax(result, Value::BIGINT(stat.intstatistics().maximum()).DefaultCastAs(type));
+			break;
+		}
+		case LogicalTypeId::DATE: {
+			if (!stat.has_datestatistics() || !stat.datestatistics().has_minimum() ||
+			    !stat.datestatistics().has_maximum()) {
+				return nullptr;
+			}
+			NumericStats::SetMin(result, Value::DATE(date_t(stat.datestatistics().minimum())));
+			NumericStats::SetMax(result, Value::DATE(date_t(stat.datestatistics().maximum())));
+			break;
+		}
+		case LogicalTypeId::TIMESTAMP: {
+			if (!stat.has_timestampstatistics() || !stat.timestampstatistics().has_minimum() ||
+			    !stat.timestampstatistics().has_maximum()) {
+				return nullptr;
+			}
+			NumericStats::SetMin(result, Value::TIMESTAMP(timestamp_t(stat.timestampstatistics().minimum())));
+			NumericStats::SetMax(result, Value::TIMESTAMP(timestamp_t(stat.timestampstatistics().maximum())));
+			break;
+		}
+		case LogicalTypeId::VARCHAR: {
+			if (!stat.has_stringstatistics() || !stat.stringstatistics().has_minimum() ||
+			    !stat.stringstatistics().has_maximum()) {
+				return nullptr;
+			}
+			StringStats::Update(result, string_t(stat.stringstatistics().minimum()));
+			StringStats::Update(result, string_t(stat.stringstatistics().maximum()));
+			// min and max say nothing about the other strings
+			StringStats::ResetMaxStringLength(result);
+			StringStats::SetContainsUnicode(result);
+			break;
+		}
+		default:
+			// decimal statistics are not reliable yet
+			return nullptr;
+	}
+	return result.ToUnique();
+}
+
 unique_ptr<GlobalTableFunctionState> PixelsScanFunction::PixelsScanInitGlobal(
     						ClientContext &context, TableFunctionInitInput &input) {
 
@@ -172,12 +450,15 @@ unique_ptr<GlobalTableFunctionState> PixelsScanFunction::PixelsScanInitGlobal(
 
 	result->initialPixelsReader = bind_data.initialPixelsReader;
 
+    // files that cannot match are dropped before they are assigned to devices and threads
+    vector<string> files = PruneFiles(bind_data, input);
+
     int max_threads = std::stoi(ConfigFactory::Instance().getProperty("pixel.threads"));
     if (max_threads <= 0) {
-        max_threads = (int) bind_data.files.size();
+        max_threads = std::max((int) files.size(), 1);
     }
 
-    result->storageArrayScheduler = std::make_shared<StorageArrayScheduler>(bind_data.files, max_threads);
+    result->storageArrayScheduler = std::make_shared<StorageArrayScheduler>(files, max_threads);
 
     result->file_index.resize(result->storageArrayScheduler->getDeviceSum());
 
@@ -187,9 +468,89 @@ unique_ptr<GlobalTableFunctionState> PixelsScanFunction::PixelsScanInitGlobal(
 
     result->filters = input.filters.get();
 
+    result->rowGroupSelection = &bind_data.rowGroupSelection;
+
+    // the scan buffers are allocated outside the buffer manager of DuckDB, so they are kept
+    // within a share of its memory limit
+    double memoryFraction = std::stod(ConfigFactory::Instance().getProperty("pixel.bufferpool.memory.fraction"));
+    if (memoryFraction > 0) {
+        auto memoryLimit = BufferManager::GetBufferManager(context).GetMaxMemory();
+        ::BufferPool::LimitBudget((uint64_t)(memoryLimit * memoryFraction));
+    }
+
+    result->queryId = (long)context.transaction.GetActiveQuery();
+    auto rateLimitedScheduler = dynamic_cast<RateLimitedScheduler *>(SchedulerFactory::Instance()->getScheduler());
+    if (rateLimitedScheduler != nullptr) {
+        Value priority("normal");
+        context.TryGetCurrentSetting("pixels_io_priority", priority);
+        rateLimitedScheduler->registerQuery(result->queryId,
+                                            RateLimitedScheduler::parsePriority(priority.ToString()));
+        result->rateLimited = true;
+    }
+
 	return std::move(result);
 }
 
+vector<string> PixelsScanFunction::PruneFiles(const PixelsReadBindData &bind_data, TableFunctionInitInput &input) {
+	// filters of the file schema columns, from the optimizer and from filter pushdown
+	unordered_map<column_t, vector<TableFilter *>> columnFilters;
+	for (auto &filter : bind_data.pruningFilters.filters) {
+		columnFilters[filter.first].emplace_back(filter.second.get());
+	}
+	if (input.filters) {
+		for (auto &filter : input.filters->filters) {
+			column_t column_id = input.column_ids.at(filter.first);
+			if (!IsRowIdColumnId(column_id)) {
+				columnFilters[column_id].emplace_back(filter.second.get());
+			}
+		}
+	}
+	if (columnFilters.empty()) {
+		return bind_data.files;
+	}
+	vector<LogicalType> types;
+	TransformDuckdbType(bind_data.fileSchema, types);
+	vector<string> files;
+	for (idx_t fileId = 0; fileId < bind_data.files.size(); fileId++) {
+		auto &columnStats = bind_data.fileTails.at(fileId)->footer().columnstats();
+		if (CheckColumnFilters(columnFilters, columnStats, types) != FilterPropagateResult::FILTER_ALWAYS_FALSE) {
+			files.emplace_back(bind_data.files.at(fileId));
+		}
+	}
+	return files;
+}
+
+FilterPropagateResult PixelsScanFunction::CheckColumnFilters(
+    const unordered_map<column_t, vector<TableFilter *>> &columnFilters,
+    const ::google::protobuf::RepeatedPtrField<pixels::proto::ColumnStatistic> &columnStats,
+    const vector<LogicalType> &types) {
+	bool alwaysTrue = true;
+	for (auto &columnFilter : columnFilters) {
+		if ((int)columnFilter.first >= columnStats.size()) {
+			alwaysTrue = false;
+			continue;
+		}
+		auto stats = TransformDuckdbStatistics(columnStats.Get((int)columnFilter.first),
+		                                       types.at(columnFilter.first));
+		if (stats == nullptr) {
+			alwaysTrue = false;
+			continue;
+		}
+		for (auto filter : columnFilter.second) {
+			auto result = filter->CheckStatistics(*stats);
+			if (result == FilterPropagateResult::FILTER_ALWAYS_FALSE) {
+				return result;
+			}
+			// the bounds say nothing about the null values, which never satisfy a comparison
+			if (result != FilterPropagateResult::FILTER_ALWAYS_TRUE ||
+			    (filter->filter_type == TableFilterType::CONSTANT_COMPARISON && stats->CanHaveNull())) {
+				alwaysTrue = false;
+			}
+		}
+	}
+	return alwaysTrue ? FilterPropagateResult::FILTER_ALWAYS_TRUE : FilterPropagateResult::NO_PRUNING_POSSIBLE;
+}
+
 unique_ptr<LocalTableFunctionState> PixelsScanFunction::PixelsScanInitLocal(
     						ExecutionContext &context, TableFunctionInitInput &input,
                             GlobalTableFunctionState *gstate_p) {
@@ -197,9 +558,20 @@ unique_ptr<LocalTableFunctionState> PixelsScanFunction::PixelsScanInitLocal(
 
 	auto &gstate = (PixelsReadGlobalState &)*gstate_p;
 
+    if (gstate.storageArrayScheduler->getDeviceSum() == 0) {
+        // every file is pruned
+        return nullptr;
+    }
+
 	auto result = make_uniq<PixelsReadLocalState>();
 
-    result->deviceID = gstate.storageArrayScheduler->acquireDeviceId();
+    result->deviceID = gstate.storageArrayScheduler->acquireDeviceId(::NumaUtil::getCurrentNode());
+    // run the thread and allocate its buffers on the node of the disk of its device
+    result->numaNode = gstate.storageArrayScheduler->getDeviceNode(result->deviceID);
+    if (result->numaNode >= 0) {
+        ::NumaUtil::runOnNode(result->numaNode);
+        ::BufferPool::SetNumaNode(result->numaNode);
+    }
 
 	result->column_ids = input.column_ids;
 
@@ -211,7 +583,7 @@ unique_ptr<LocalTableFunctionState> PixelsScanFunction::PixelsScanInitLocal(
 		}
 	}
 
-    ::DirectUringRandomAccessFile::Initialize();
+    ::LocalFS::initializeAsyncIo();
 	if(!PixelsParallelStateNext(context.client, bind_data, *result, gstate, true)) {
 		return nullptr;
 	}
@@ -400,15 +772,8 @@ bool PixelsScanFunction::PixelsParallelStateNext(ClientContext &context, const P
     // done, so the function return false.
     if ((is_init_state && parallel_state.file_index.at(scan_data.deviceID) >= StorageInstance->getFileSum(scan_data.deviceID)) ||
             scan_data.next_file_index >= StorageInstance->getFileSum(scan_data.deviceID)) {
-		::BufferPool::Reset();
-		// if async io is enabled, we need to unregister uring buffer
-		if(ConfigFactory::Instance().boolCheckProperty("localfs.enable.async.io")) {
-			if(ConfigFactory::Instance().getProperty("localfs.async.lib") == "iouring") {
-				::DirectUringRandomAccessFile::Reset();
-			} else if(ConfigFactory::Instance().getProperty("localfs.async.lib") == "aio") {
-				throw InvalidArgumentException("PhysicalLocalReader::readAsync: We don't support aio for our async read yet.");
-			}
-		}
+		scan_data.ReleaseBuffers();
+		scan_data.Unpin();
         parallel_lock.unlock();
         return false;
     }
@@ -420,6 +785,8 @@ bool PixelsScanFunction::PixelsParallelStateNext(ClientContext &context, const P
     scan_data.curr_file_name = scan_data.next_file_name;
     parallel_state.file_index.at(scan_data.deviceID)++;
     parallel_lock.unlock();
+    scan_data.holdsBuffers = true;
+    scan_data.threadId = std::this_thread::get_id();
     // The below code uses global state but no race happens, so we don't need the lock anymore
     
 
@@ -427,16 +794,19 @@ bool PixelsScanFunction::PixelsParallelStateNext(ClientContext &context, const P
         scan_data.currReader->close();
     }
 
-    ::BufferPool::Switch();
     scan_data.currReader = scan_data.nextReader;
     scan_data.currPixelsRecordReader = scan_data.nextPixelsRecordReader;
     // asyncReadComplete is not invoked in the first run (is_init_state = true)
     if (scan_data.currPixelsRecordReader != nullptr) {
         auto currPixelsRecordReader = std::static_pointer_cast<PixelsRecordReaderImpl>(scan_data.currPixelsRecordReader);
+        // the file is not prefetched, so it is read into the buffers of the file just closed
+        if (!currPixelsRecordReader->isEverRead()) {
+            currPixelsRecordReader->read();
+        }
         currPixelsRecordReader->asyncReadComplete((int)scan_data.column_names.size());
     }
     if(scan_data.next_file_index < StorageInstance->getFileSum(scan_data.deviceID)) {
-        auto footerCache = std::make_shared<PixelsFooterCache>();
+        auto footerCache = PixelsFooterCache::Instance();
         auto builder = std::make_shared<PixelsReaderBuilder>();
         std::shared_ptr<::Storage> storage = StorageFactory::getInstance()->getStorage(::Storage::file);
         scan_data.next_file_name = StorageInstance->getFileName(scan_data.deviceID, scan_data.next_file_index);
@@ -447,8 +817,13 @@ bool PixelsScanFunction::PixelsParallelStateNext(ClientContext &context, const P
 
         PixelsReaderOption option = GetPixelsReaderOption(scan_data, parallel_state);
         scan_data.nextPixelsRecordReader = scan_data.nextReader->read(option);
-        auto nextPixelsRecordReader = std::static_pointer_cast<PixelsRecordReaderImpl>(scan_data.nextPixelsRecordReader);
-        nextPixelsRecordReader->read();
+        // prefetch the next file into the other buffers, unless the buffer pool is short of
+        // memory. Then the next file is read when it becomes the current one
+        if (::BufferPool::ShouldPrefetch()) {
+            ::BufferPool::Switch();
+            auto nextPixelsRecordReader = std::static_pointer_cast<PixelsRecordReaderImpl>(scan_data.nextPixelsRecordReader);
+            nextPixelsRecordReader->read();
+        }
     } else {
         scan_data.nextReader = nullptr;
         scan_data.nextPixelsRecordReader = nullptr;
@@ -466,7 +841,13 @@ PixelsReaderOption PixelsScanFunction::GetPixelsReaderOption(PixelsReadLocalStat
     // includeCols comes from the caller of PixelsPageSource
     option.setIncludeCols(local_state.column_names);
     option.setRGRange(0, local_state.nextReader->getRowGroupNum());
-    option.setQueryId(1);
+    if (global_state.rowGroupSelection != nullptr) {
+        auto selection = global_state.rowGroupSelection->find(local_state.next_file_name);
+        if (selection != global_state.rowGroupSelection->end()) {
+            option.setRGSelection(selection->second);
+        }
+    }
+    option.setQueryId(global_state.queryId);
     int stride = std::stoi(ConfigFactory::Instance().getProperty("pixel.stride"));
     option.setBatchSize(stride);
     return option;
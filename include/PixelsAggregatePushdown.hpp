@@ -0,0 +1,34 @@
+//
+// Created by pixels on 10/18/26.
+//
+
+#ifndef DUCKDB_PIXELSAGGREGATEPUSHDOWN_HPP
+#define DUCKDB_PIXELSAGGREGATEPUSHDOWN_HPP
+
+#include "duckdb.hpp"
+#include "duckdb/optimizer/optimizer_extension.hpp"
+#include "duckdb/planner/logical_operator.hpp"
+
+namespace duckdb {
+
+/**
+ * Answers ungrouped min/max/count/sum over pixels_scan from the footer statistics.
+ * Files whose column statistics answer every aggregate are not scanned at all. Otherwise
+ * the row group statistics are used, and only the row groups with inconclusive statistics
+ * are left to the scan, whose aggregate is combined with the partial results.
+ *
+ * Under a WHERE clause whose conditions are all pruning filters of the scan, only the files
+ * and row groups whose statistics show that every row satisfies them are answered this way,
+ * and those that no row can satisfy are dropped.
+ */
+class PixelsAggregatePushdown {
+public:
+	static OptimizerExtension GetOptimizerExtension();
+	static void Optimize(OptimizerExtensionInput &input, unique_ptr<LogicalOperator> &plan);
+private:
+	static bool TryRewrite(OptimizerExtensionInput &input, unique_ptr<LogicalOperator> &op);
+};
+
+} // namespace duckdb
+
+#endif // DUCKDB_PIXELSAGGREGATEPUSHDOWN_HPP
@@ -11,7 +11,10 @@
 #include "duckdb/common/string_util.hpp"
 #include "duckdb/function/scalar_function.hpp"
 #include <duckdb/parser/parsed_data/create_scalar_function_info.hpp>
+#include "duckdb/storage/statistics/base_statistics.hpp"
+#include "duckdb/planner/table_filter.hpp"
 #include "PixelsReader.h"
+#include "PixelsFooterCache.h"
 
 
 namespace duckdb {
@@ -21,6 +24,20 @@ struct PixelsReadBindData : public TableFunctionData {
 	std::shared_ptr<TypeDescription> fileSchema;
 	vector<string> files;
 	atomic<idx_t> curFileId;
+	//! Process-wide footer cache, see PixelsFooterCache::Instance()
+	std::shared_ptr<PixelsFooterCache> footerCache;
+	//! Tail of each file, in the order of files
+	vector<std::shared_ptr<pixels::proto::FileTail>> fileTails;
+	//! Number of rows of each file, in the order of files
+	vector<idx_t> fileRowCounts;
+	//! Statistics of each column merged from all file footers, nullptr if some file has none
+	vector<unique_ptr<BaseStatistics>> columnStatistics;
+	//! Row groups to read per file, filled by the optimizer when only part of a file has to be scanned.
+	//! Files missing from the map are read completely.
+	unordered_map<string, std::vector<bool>> rowGroupSelection;
+	//! Filters of the query keyed by column id of the file schema, used to skip whole files
+	//! whose footer statistics cannot match. They are only a copy, the query still applies them.
+	TableFilterSet pruningFilters;
 };
 
 }
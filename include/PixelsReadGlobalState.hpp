@@ -12,6 +12,7 @@
 #include <duckdb/parser/parsed_data/create_scalar_function_info.hpp>
 #include "PixelsReader.h"
 #include "physical/StorageArrayScheduler.h"
+#include "physical/SchedulerFactory.h"
 
 namespace duckdb {
 
@@ -39,6 +40,24 @@ struct PixelsReadGlobalState : public GlobalTableFunctionState {
 
     TableFilterSet * filters;
 
+	//! Row groups to read per file, owned by the bind data
+	const unordered_map<string, std::vector<bool>> * rowGroupSelection;
+
+	//! Id of the query that runs this scan, passed to the read request scheduler
+	long queryId;
+
+	//! Whether the scan is registered to the ratelimited scheduler
+	bool rateLimited = false;
+
+	~PixelsReadGlobalState() override {
+		if (rateLimited) {
+			auto scheduler = dynamic_cast<RateLimitedScheduler *>(SchedulerFactory::Instance()->getScheduler());
+			if (scheduler != nullptr) {
+				scheduler->unregisterQuery(queryId);
+			}
+		}
+	}
+
 	idx_t MaxThreads() const override {
 		return max_threads;
 	}
@@ -12,6 +12,11 @@
 #include <duckdb/parser/parsed_data/create_scalar_function_info.hpp>
 #include "PixelsReader.h"
 #include "reader/PixelsRecordReader.h"
+#include "reader/PixelsRecordReaderImpl.h"
+#include "physical/BufferPool.h"
+#include "utils/NumaUtil.h"
+#include <climits>
+#include <thread>
 
 namespace duckdb {
 
@@ -27,12 +32,61 @@ struct PixelsReadLocalState : public LocalTableFunctionState {
         vectorizedRowBatch = nullptr;
         currReader = nullptr;
         nextReader = nullptr;
+        numaNode = -1;
+        holdsBuffers = false;
+        threadId = std::this_thread::get_id();
+    }
+    // A scan may also end by LIMIT, an error or an interrupt before the thread uses up the files
+    // of its device, so the buffers are released here as well
+    ~PixelsReadLocalState() override {
+        ReleaseBuffers();
+        Unpin();
+    }
+    // complete the pending reads of the scan and return its buffers to the pool of the thread
+    void ReleaseBuffers() {
+        // the buffers and the io_uring ring belong to the thread that scanned
+        if (!holdsBuffers || threadId != std::this_thread::get_id()) {
+            return;
+        }
+        holdsBuffers = false;
+        // the kernel must not write into the buffers once they are reused. An error of the scan
+        // may leave reads of the batch in flight, so all the submitted reads are waited for
+        bool drained = true;
+        for (auto &recordReader : {currPixelsRecordReader, nextPixelsRecordReader}) {
+            auto recordReaderImpl = std::static_pointer_cast<PixelsRecordReaderImpl>(recordReader);
+            if (recordReaderImpl != nullptr && !recordReaderImpl->asyncReadDrain()) {
+                drained = false;
+            }
+        }
+        if (drained) {
+            // the buffers are kept in the free lists for the next scan
+            ::BufferPool::Reset();
+        } else {
+            std::cerr << "PixelsReadLocalState: failed to drain the pending reads, their buffers are not reused"
+                      << std::endl;
+            ::BufferPool::Abandon();
+        }
+    }
+    // the thread is shared with other operators, so it is not pinned after the scan
+    void Unpin() {
+        if (numaNode < 0 || threadId != std::this_thread::get_id()) {
+            return;
+        }
+        ::NumaUtil::runOnNode(-1);
+        ::BufferPool::SetNumaNode(-1);
+        numaNode = -1;
     }
 	std::shared_ptr<PixelsRecordReader> currPixelsRecordReader;
     std::shared_ptr<PixelsRecordReader> nextPixelsRecordReader;
 	// this is used for storing row batch results.
 	std::shared_ptr<VectorizedRowBatch> vectorizedRowBatch;
     int deviceID;
+    // whether the scan holds buffers of the pool of the thread threadId
+    bool holdsBuffers;
+    // the thread that runs the scan, which is also the thread pinned to numaNode
+    std::thread::id threadId;
+    // the NUMA node that the thread runs on during the scan, -1 if it is not pinned
+    int numaNode;
 	int rowOffset;
 	vector<column_t> column_ids;
 	vector<string> column_names;
@@ -12,6 +12,7 @@
 #include <string>
 #include <vector>
 #include <cstdio>
+#include <filesystem>
 #include "duckdb/common/exception.hpp"
 #include "duckdb/common/string_util.hpp"
 #include "duckdb/function/scalar_function.hpp"
@@ -34,6 +35,7 @@
 #include "physical/SchedulerFactory.h"
 #include "PixelsVersion.h"
 #include "PixelsFooterCache.h"
+#include "PixelsManifest.h"
 #include "exception/PixelsReaderException.h"
 #include "reader/PixelsReaderOption.h"
 #include "TypeDescription.h"
@@ -85,9 +87,32 @@ public:
 	                                     PixelsReadLocalState &scan_data, PixelsReadGlobalState &parallel_state,
                                          bool is_init_state = false);
     static PixelsReaderOption GetPixelsReaderOption(PixelsReadLocalState &local_state, PixelsReadGlobalState &global_state);
-private:
+	/**
+	 * Transform a filter expression over a column of the get into a filter that can be checked
+	 * against the footer statistics.
+	 * @param column_id set to the column id of the file schema
+	 * @return nullptr if the expression can't be checked against the statistics
+	 */
+	static unique_ptr<TableFilter> TransformPruningFilter(const LogicalGet &get, const Expression &filter,
+	                                                      column_t &column_id);
+	/**
+	 * Check the filters of the file schema columns against the statistics of a file or a row group.
+	 * @return FILTER_ALWAYS_FALSE if no row matches, FILTER_ALWAYS_TRUE if every row matches all
+	 * the filters, NO_PRUNING_POSSIBLE otherwise
+	 */
+	static FilterPropagateResult CheckColumnFilters(
+	    const unordered_map<column_t, vector<TableFilter *>> &columnFilters,
+	    const ::google::protobuf::RepeatedPtrField<pixels::proto::ColumnStatistic> &columnStats,
+	    const vector<LogicalType> &types);
 	static void TransformDuckdbType(const std::shared_ptr<TypeDescription>& type,
 	                         vector<LogicalType> &return_types);
+private:
+	static vector<std::shared_ptr<pixels::proto::FileTail>>
+	LoadManifestFileTails(const vector<string> &files, const std::shared_ptr<PixelsFooterCache> &footerCache);
+	static void CollectFileStatistics(PixelsReadBindData &bind_data, const vector<LogicalType> &return_types);
+	static vector<string> PruneFiles(const PixelsReadBindData &bind_data, TableFunctionInitInput &input);
+	static unique_ptr<BaseStatistics> TransformDuckdbStatistics(const pixels::proto::ColumnStatistic &stat,
+	                                                            const LogicalType &type);
 	static void TransformDuckdbChunk(PixelsReadLocalState & data,
 	                            DataChunk &output,
 	                            const std::shared_ptr<TypeDescription> & schema,
@@ -34,6 +34,6 @@ public:
     void execute(const bpo::variables_map& ns, const std::string& command) override;
 private:
     bool startConsumers(const std::vector<std::string> &inputFiles, Parameters parameters,
-                        const std::vector<std::string> &loadedFiles);
+                        std::vector<std::string> &loadedFiles);
 };
 #endif //PIXELS_LOADEXECUTOR_H
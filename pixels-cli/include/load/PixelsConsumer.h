@@ -33,6 +33,7 @@ class PixelsConsumer {
 public:
     PixelsConsumer(const std::vector<std::string> &queue, const Parameters &parameters, const std::vector<std::string> &loadedFiles);
     void run();
+    const std::vector<std::string> &getLoadedFiles() const;
 private:
     static int GlobalTargetPathId;
     std::vector<std::string> queue;
@@ -29,6 +29,7 @@
 #include <load/Parameters.h>
 #include <chrono>
 #include <load/PixelsConsumer.h>
+#include <PixelsManifest.h>
 
 void LoadExecutor::execute(const bpo::variables_map& ns, const std::string& command) {
     std::string schema = ns["schema"].as<std::string>();
@@ -53,6 +54,15 @@ void LoadExecutor::execute(const bpo::variables_map& ns, const std::string& comm
 
     auto startTime = std::chrono::system_clock::now();
     if (startConsumers(inputFiles, parameters, loadedFiles)) {
+        // record the new files in the manifest of the target directory
+        if (!loadedFiles.empty()) {
+            try {
+                PixelsManifest::update(target, loadedFiles);
+            } catch (std::exception &e) {
+                // the files are loaded, scans skip the stale entries and read the tails of the new files
+                std::cerr << "the manifest of " << target << " is stale, rebuild it by MANIFEST: " << e.what() << std::endl;
+            }
+        }
         std::cout << command << " is successful" << std::endl;
     } else {
         std::cout << command << " failed" << std::endl;
@@ -64,8 +74,9 @@ void LoadExecutor::execute(const bpo::variables_map& ns, const std::string& comm
 }
 
 bool LoadExecutor::startConsumers(const std::vector<std::string> &inputFiles, Parameters parameters,
-                                  const std::vector<std::string> &loadedFiles) {
+                                  std::vector<std::string> &loadedFiles) {
     PixelsConsumer consumer(inputFiles, parameters, loadedFiles);
     consumer.run();
+    loadedFiles = consumer.getLoadedFiles();
     return true;
 }
\ No newline at end of file
@@ -152,4 +152,8 @@ void PixelsConsumer::run() {
         this->loadedFiles.push_back(targetFilePath);
     }
     std::cout << "Exit PixelsConsumer" << std::endl;
-}
\ No newline at end of file
+}
+
+const std::vector<std::string> &PixelsConsumer::getLoadedFiles() const {
+    return loadedFiles;
+}
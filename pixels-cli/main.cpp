@@ -28,6 +28,7 @@
 #include <boost/algorithm/string.hpp>
 #include <boost/program_options.hpp>
 #include <executor/LoadExecutor.h>
+#include <executor/ManifestExecutor.h>
 
 namespace bpo = boost::program_options;
 
@@ -67,7 +68,8 @@ int main () {
                         "STAT\n" <<
                         "QUERY\n" <<
                         "COPY\n" <<
-                        "FILE_META\n";
+                        "FILE_META\n" <<
+                        "MANIFEST\n";
             std::cout << "{command} -h to show the usage of a command.\nexit / quit / -q to exit.\n";
             continue;
         }
@@ -115,6 +117,27 @@ int main () {
             // free loadExecutor
             delete loadExecutor;
         }
+        else if (command == "MANIFEST") {
+            bpo::options_description desc("Pixels MANIFEST");
+            desc.add_options()
+                    ("help,h", "show this help message and exit")
+                    ("directory,d", bpo::value<std::string>()->required(), "specify the directory of pixels files");
+
+            bpo::variables_map vm;
+            try {
+                bpo::store(bpo::parse_command_line(argv.size(), argv.data(), desc), vm);
+                if (vm.count("help")) {
+                    std::cout << desc << std::endl;
+                    continue;
+                }
+                bpo::notify(vm);
+            } catch (const bpo::error& e) {
+                std::cerr << "Error parsing options: " << e.what() << "\n";
+                continue;
+            }
+            ManifestExecutor manifestExecutor;
+            manifestExecutor.execute(vm, command);
+        }
         else if (command == "QUERY") {
             std::cout << "Not implemented yet." << std::endl;
         }
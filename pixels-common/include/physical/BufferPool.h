@@ -13,29 +13,109 @@
 #include "exception/InvalidArgumentException.h"
 #include "utils/ColumnSizeCSVReader.h"
 #include <map>
-
-// when allocating buffer pool, we use the size of the first pxl file. Consider that
-// the remaining pxl file has larger size than the first file, we allocate some extra
-// size (10MB) to each column.
-// TODO: how to evaluate the maximal pool size
-#define EXTRA_POOL_SIZE 3*1024*1024
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
 
 class DirectUringRandomAccessFile;
 // This class is global class. The variable is shared by each thread
+// The direct buffers of a thread live as long as the thread. Their sizes are powers of two
+// (size classes), and the buffers that no column of the current scan uses are kept in a free
+// list per size class, so that the next scan or a larger chunk reuses them. Reset() returns
+// all buffers of the scan to the free lists, and the free buffers are released once the
+// buffers of all threads exceed the budget.
+//
+// The budget (pixel.bufferpool.max.size, optionally lowered by LimitBudget) bounds the bytes
+// of the buffers that scans hold. A thread that needs more waits until other scans return
+// theirs, and the scan only prefetches the next file into the second set of buffers when
+// ShouldPrefetch() finds room for it. A thread goes beyond the budget only when no other
+// holder of buffers could release any, so that scans never wait for each other forever.
 class BufferPool {
 public:
+	/**
+	 * Assign the buffers of the current file, which may wait for other threads to release
+	 * buffers if the budget is reached.
+	 * @param bytes the largest chunk of each column in the file, which is read from the row group footers
+	 */
 	static void Initialize(std::vector<uint32_t> colIds, std::vector<uint64_t> bytes, std::vector<std::string> columnNames);
 	static std::shared_ptr<ByteBuffer> GetBuffer(uint32_t colId);
-    static int64_t GetBufferId(uint32_t index);
+    // the index of the buffer of this column among the registered io_uring buffers
+    static int64_t GetBufferId(uint32_t colId);
+    /**
+     * Get a buffer for a read that merges the chunks of several columns.
+     * @param index the index of the merged read among the merged reads of the current file
+     * @param size the minimal size of the buffer
+     * @param bufferId set to the registered index of the buffer
+     */
+    static std::shared_ptr<ByteBuffer> GetMergedBuffer(uint32_t index, uint64_t size, int64_t & bufferId);
     static void Switch();
 	static void Reset();
+	/**
+	 * Give up the buffers of the scan without returning them to the free lists, because the
+	 * kernel may still write into them, e.g., the pending reads of a failed scan can't be waited
+	 * for. The buffers are no longer counted as held, and they are kept until the thread exits.
+	 */
+	static void Abandon();
+	/**
+	 * @return true if the next file can be read into the other set of buffers while the
+	 * current file is being scanned, false if the thread should read one file at a time
+	 */
+	static bool ShouldPrefetch();
+	// lower the budget to the given bytes, e.g., a share of the memory limit of DuckDB
+	static void LimitBudget(uint64_t bytes);
+	static uint64_t GetBudget();
+	/**
+	 * Allocate the buffers of this thread on the NUMA node from now on. The free buffers on
+	 * other nodes are not reused while the node is set. -1 means the default placement.
+	 */
+	static void SetNumaNode(int node);
+	// the bytes of the direct buffers of all threads
+	static uint64_t GetTotalBytes();
+	// the bytes of the direct buffers that scans hold, excluding the free buffers
+	static uint64_t GetHeldBytes();
 private:
 	BufferPool() = default;
+	static void InitializeDirectIoLib();
+	// the size class of a buffer that can hold a direct read of the given length
+	static int SizeClassOf(uint64_t length);
+	static uint32_t AcquireSlot(uint64_t length);
+	static void ReleaseSlot(uint32_t slot);
+	// wait until the bytes fit in the budget, then count them as held by this thread
+	static void Reserve(uint64_t bytes);
+	static void Unreserve(uint64_t bytes);
+	// free the buffers in the free lists, the largest first, until all threads are within the budget
+	static void TrimFreeBuffers(uint64_t budget);
 	static thread_local int colCount;
-	static thread_local std::map<uint32_t, uint64_t> nrBytes;
-	static thread_local bool isInitialized;
-	static thread_local std::map<uint32_t, std::shared_ptr<ByteBuffer>> buffers[2];
-	static std::shared_ptr<DirectIoLib> directIoLib;
+	// column id -> index of its buffer in the arena, for the current and the next file
+	static thread_local std::map<uint32_t, uint32_t> slotIds[2];
+	// index of merged read -> index of its buffer in the arena, for the current and the next file
+	static thread_local std::vector<uint32_t> mergedSlotIds[2];
+	// the direct buffers of this thread, the index of a buffer is also its registered index.
+	// A released buffer leaves a nullptr, whose index is reused by the next new buffer
+	static thread_local std::vector<std::shared_ptr<ByteBuffer>> arena;
+	static thread_local std::vector<int> arenaSizeClass;
+	static thread_local std::vector<int> arenaNode;
+	static thread_local int numaNode;
+	static thread_local std::vector<uint32_t> emptySlots;
+	// size class -> indexes of the free buffers of the class
+	static thread_local std::map<int, std::vector<uint32_t>> freeLists;
+	// the arena indexes that are (re)allocated or released but not registered to io_uring yet
+	static thread_local std::vector<uint32_t> dirtySlots;
+	static thread_local std::shared_ptr<DirectIoLib> directIoLib;
+	static thread_local int fsBlockSize;
+	static std::atomic<uint64_t> totalBytes;
+	// the bytes held by the scans of all threads and of this thread
+	static std::atomic<uint64_t> heldBytes;
+	static thread_local uint64_t threadHeldBytes;
+	// pixel.bufferpool.max.size, 0 means unlimited
+	static uint64_t GetMaxBytes();
+	// the limit given by LimitBudget, 0 means none
+	static std::atomic<uint64_t> budgetLimit;
+	static std::mutex budgetLock;
+	static std::condition_variable budgetReleased;
+	// the threads that hold buffers, and those of them that are waiting for more
+	static int holdingThreads;
+	static int waitingHolders;
     static thread_local int currBufferIdx;
     static thread_local int nextBufferIdx;
     friend class DirectUringRandomAccessFile;
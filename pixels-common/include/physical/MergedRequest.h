@@ -16,7 +16,7 @@
 
 class MergedRequest: public std::enable_shared_from_this<MergedRequest> {
 public:
-    MergedRequest(Request first);
+    MergedRequest(Request first, long maxGap);
     std::shared_ptr<MergedRequest> merge(Request curr);
     std::vector<std::shared_ptr<ByteBuffer>> complete(std::shared_ptr<ByteBuffer> buffer);
     long getStart();
@@ -29,7 +29,7 @@ private:
     long end;
     int length; // the length of merged request
     int size;   // the number of sub-requests
-    int maxGap;
+    long maxGap;
     std::vector<int> offsets; // the starting offset of the sub-requests in the response of the merged request
     std::vector<int> lengths; // the length of sub-requests
 };
@@ -49,7 +49,11 @@ public:
 //    virtual int readInt() = 0;
     virtual void close() = 0;
 
-//    virtual std::string getPath() = 0;
+    /**
+     * Get the full path of the file, without the scheme.
+     * @return
+     */
+    virtual std::string getPath() = 0;
 
     /**
     * Get the last domain in path.
@@ -27,6 +27,8 @@
 
 #include <cstdint>
 #include <string>
+#include <vector>
+#include <sys/uio.h>
 #include "physical/natives/ByteBuffer.h"
 
 
@@ -56,6 +58,21 @@ public:
      * @return start offset of content in the file
      */
      virtual std::int64_t append(std::shared_ptr<ByteBuffer> byteBuffer) =0 ;
+    /**
+     * Append the buffers to the file in order, with as few writes as the storage allows.
+     * @param buffers the content buffers, they are not copied
+     * @return start offset of the first buffer in the file
+     */
+    virtual std::int64_t append(const std::vector<struct iovec> &buffers) {
+        std::int64_t start = -1;
+        for (const auto &buffer : buffers) {
+            std::int64_t offset = append(static_cast<const uint8_t *>(buffer.iov_base), 0, buffer.iov_len);
+            if (start == -1) {
+                start = offset;
+            }
+        }
+        return start;
+    }
     /**
      * Close writer.
      */
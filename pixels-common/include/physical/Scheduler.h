@@ -20,5 +20,12 @@ public:
 	virtual std::vector<std::shared_ptr<ByteBuffer>> executeBatch(std::shared_ptr<PhysicalReader> reader, RequestBatch batch, long queryId) = 0;
     virtual std::vector<std::shared_ptr<ByteBuffer>> executeBatch(std::shared_ptr<PhysicalReader> reader,
 	                                                              RequestBatch batch, std::vector<std::shared_ptr<ByteBuffer>> reuseBuffers, long queryId) = 0;
+    /**
+      * Observe the reads of a batch once they are complete, so that the scheduler can adapt to the device.
+      * @param requests the number of read requests issued to the device
+      * @param bytes the number of bytes read
+      * @param seconds the time from issuing the reads to their completion
+      */
+    virtual void observe(int requests, uint64_t bytes, double seconds) {}
 };
 #endif //PIXELS_SCHEDULER_H
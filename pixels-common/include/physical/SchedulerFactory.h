@@ -8,6 +8,7 @@
 #include "physical/Scheduler.h"
 #include "physical/scheduler/NoopScheduler.h"
 #include "physical/scheduler/SortMergeScheduler.h"
+#include "physical/scheduler/RateLimitedScheduler.h"
 #include "utils/ConfigFactory.h"
 #include <algorithm>
 #include <cctype>
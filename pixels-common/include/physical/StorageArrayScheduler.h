@@ -13,8 +13,15 @@
 class StorageArrayScheduler {
 public:
     StorageArrayScheduler(std::vector<std::string>& files, int threadNum);
-    int acquireDeviceId();
+    /**
+     * Assign a device to a scan thread. The devices with the fewest threads come first, and
+     * among them the devices attached to the preferred NUMA node.
+     * @param preferredNode the NUMA node of the thread, -1 means no preference
+     */
+    int acquireDeviceId(int preferredNode = -1);
     int getDeviceSum();
+    // the NUMA node of the device, -1 if unknown or NUMA is disabled
+    int getDeviceNode(int deviceID);
 
     std::string getFileName(int deviceID, int fileID);
     uint64_t getFileSum(int deviceID);
@@ -25,6 +32,8 @@ private:
     int currentDeviceID;
     int devicesNum;
     std::vector<std::vector<std::string>> filesVector;
+    std::vector<int> deviceNodes;
+    std::vector<int> deviceThreads;
 };
 
 #endif //DUCKDB_STORAGEARRAYSCHEDULER_H
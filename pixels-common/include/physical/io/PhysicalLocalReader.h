@@ -9,6 +9,7 @@
 #include "physical/storage/LocalFS.h"
 #include "physical/natives/DirectRandomAccessFile.h"
 #include "physical/natives/DirectUringRandomAccessFile.h"
+#include "physical/natives/DirectAioRandomAccessFile.h"
 #include <iostream>
 #include <atomic>
 
@@ -19,9 +20,17 @@ public:
     std::shared_ptr<ByteBuffer> readFully(int length) override;
 	std::shared_ptr<ByteBuffer> readFully(int length, std::shared_ptr<ByteBuffer> bb) override;
 	std::shared_ptr<ByteBuffer> readAsync(int length, std::shared_ptr<ByteBuffer> bb, int index);
-	void readAsyncSubmit(uint32_t size);
+	/**
+	 * @param observer if not null, observes the time of the reads from submission to completion,
+	 * when the completion is waited for
+	 */
+	void readAsyncSubmit(uint32_t size, Scheduler * observer = nullptr);
 	void readAsyncComplete(uint32_t size);
 	void readAsyncSubmitAndComplete(uint32_t size);
+	// wait for all the submitted async reads without throwing, false if they can't be waited for
+	bool readAsyncDrain();
+	// the number of submitted async reads that are not completed yet
+	int getAsyncNumRequests();
     void close() override;
     long getFileLength() override;
     void seek(long desired) override;
@@ -29,6 +38,7 @@ public:
     int readInt() override;
     char readChar() override;
     std::string getName() override;
+    std::string getPath() override;
 private:
     std::shared_ptr<LocalFS> local;
     std::string path;
@@ -36,6 +46,10 @@ private:
     std::atomic<int> numRequests;
 	std::atomic<int> asyncNumRequests;
 	std::shared_ptr<PixelsRandomAccessFile> raf;
+	// the async backend of raf, fixed when the file is opened. LocalFS may fall back to aio
+	// for the files opened later, which does not change the type of raf
+	std::shared_ptr<DirectUringRandomAccessFile> uringRaf;
+	std::shared_ptr<DirectAioRandomAccessFile> aioRaf;
 
 };
 
@@ -38,6 +38,8 @@ class ByteBuffer {
 public:
     ByteBuffer(uint32_t size = BB_DEFAULT_SIZE);
     ByteBuffer(uint8_t* arr, uint32_t size, bool allocated_by_new = true);
+    // the buffer is freed by deallocator(arr, size), e.g., if it is mapped by mmap
+    ByteBuffer(uint8_t* arr, uint32_t size, void (*deallocator)(uint8_t *, uint32_t));
     ByteBuffer(ByteBuffer & bb, uint32_t startId, uint32_t length);
     ~ByteBuffer();
     void filp();// reset the readPosition
@@ -46,6 +48,8 @@ public:
     uint32_t size(); // Size of internal vector
     uint8_t * getPointer(); // get the pointer of bytebuffer
     void resetPosition();
+    // make room for len more bytes after the write position, so that writing them does not grow the buffer
+    void reserve(uint32_t len);
     // Read
     uint8_t peek(); // Relative peek. Reads and returns the next uint8_t in the buffer from the current position but does not increment the read position
     uint8_t get(); // Relative get method. Reads the uint8_t at the buffers current position then increments the position
@@ -130,6 +134,7 @@ protected:
 	// Sometimes the buffer is allocated by malloc/poxis_memalign, in this case, we
 	// should use free() to deallocate the buf
 	bool allocated_by_new;
+	void (*deallocator)(uint8_t *, uint32_t);
 private:
     template<typename T> T read() {
         T data = read<T>(rpos);
@@ -147,11 +152,14 @@ private:
         return 0;
     }
 
+    // grow the buffer geometrically to hold at least required bytes, if it owns the buffer
+    void ensureCapacity(uint32_t required);
+
     template<typename T> void append(T data) {
         uint32_t s = sizeof(data);
 
         if (size() < (wpos + s)) {
-            throw std::runtime_error("Append exceeds the size of buffer");
+            ensureCapacity(wpos + s);
         }
         memcpy(&buf[wpos], (uint8_t*) &data, s);
         //printf("writing %c to %i\n", (uint8_t)data, wpos);
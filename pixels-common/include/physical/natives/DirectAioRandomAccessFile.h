@@ -0,0 +1,82 @@
+//
+// Created by pixels on 10/18/26.
+//
+
+#ifndef DUCKDB_DIRECTAIORANDOMACCESSFILE_H
+#define DUCKDB_DIRECTAIORANDOMACCESSFILE_H
+
+#include <linux/aio_abi.h>
+#include <chrono>
+#include <unordered_map>
+#include "physical/natives/DirectRandomAccessFile.h"
+#include "exception/InvalidArgumentException.h"
+#include "DirectIoLib.h"
+#include "physical/BufferPool.h"
+
+class Scheduler;
+
+/**
+ * The async reads of localfs.async.lib=aio, based on the io_submit family of syscalls.
+ *
+ * It follows the submit/complete contract of DirectUringRandomAccessFile, so that kernels
+ * where io_uring is disabled still read asynchronously. Each thread owns one aio context.
+ */
+class DirectAioRandomAccessFile: public DirectRandomAccessFile {
+public:
+	explicit DirectAioRandomAccessFile(const std::string& file);
+	// the aio context of a thread is created once and kept until the thread exits
+	static void Initialize();
+	static void Reset();
+	// index is the registered buffer index of io_uring, which aio does not need
+	std::shared_ptr<ByteBuffer> readAsync(int length, std::shared_ptr<ByteBuffer> buffer, int index);
+	/**
+	 * Submit the reads prepared by readAsync.
+	 * @param observer if not null, observes the time from submitting the reads to their completion
+	 */
+	void readAsyncSubmit(int size, Scheduler * observer = nullptr);
+	void readAsyncComplete(int size);
+	/**
+	 * Wait for all the submitted reads of this file, including those abandoned by an error, and
+	 * drop those not submitted yet. It does not throw.
+	 * @return false if the reads can't be waited for, then their buffers must not be reused
+	 */
+	bool drain();
+	~DirectAioRandomAccessFile();
+private:
+	// the reads of one submission, observed when the last of them completes
+	struct AsyncBatch {
+		Scheduler * observer;
+		std::chrono::steady_clock::time_point submitted;
+		int reads;
+		uint64_t bytes;
+		int remaining;
+	};
+	struct PendingRead {
+		DirectAioRandomAccessFile * file;
+		// the bytes at the head of the read that the caller needs, the rest may lie beyond the end of file
+		uint32_t required;
+		std::shared_ptr<AsyncBatch> batch;
+	};
+	/**
+	 * Wait for at least one completion and reap the ready ones.
+	 * @param waited set once the thread blocks for a completion, from then on a completion is
+	 * reaped soon after it arrives, so the time of its batch is observed
+	 * @return false if waiting fails
+	 */
+	static bool ReapCompletions(bool & waited);
+	static thread_local aio_context_t context;
+	// the reads prepared by readAsync and not submitted yet
+	static thread_local std::vector<struct iocb> unsubmitted;
+	// the in-flight reads of the context, keyed by the aio_data of their iocb
+	static thread_local std::unordered_map<uint64_t, PendingRead> pendingReads;
+	static thread_local uint64_t nextUserData;
+	uint32_t completedReads = 0;
+	// the reads of this file in pendingReads
+	uint32_t inflightReads = 0;
+	// the user_data and the bytes of the reads prepared by readAsync and not submitted yet
+	std::vector<uint64_t> preparedReads;
+	uint64_t preparedBytes = 0;
+	// the last failed read of this file, reported by readAsyncComplete
+	std::string readError;
+};
+#endif // DUCKDB_DIRECTAIORANDOMACCESSFILE_H
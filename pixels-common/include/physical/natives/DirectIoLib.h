@@ -37,12 +37,15 @@ public:
 	 */
 	DirectIoLib(int fsBlockSize);
 	std::shared_ptr<ByteBuffer> allocateDirectBuffer(long size);
+	// the NUMA node of the buffers allocated afterwards, -1 means the default placement
+	void setNumaNode(int numaNode);
 	std::shared_ptr<ByteBuffer> read(int fd, long fileOffset, std::shared_ptr<ByteBuffer> directBuffer, long length);
 	long blockStart(long value);
 	long blockEnd(long value);
 private:
 	int fsBlockSize;
 	long fsBlockNotMask;
+	int numaNode;
 };
 
 #endif // DUCKDB_DIRECTIOLIB_H
@@ -11,21 +11,75 @@
 #include "exception/InvalidArgumentException.h"
 #include "DirectIoLib.h"
 #include "physical/BufferPool.h"
+#include <chrono>
+#include <unordered_map>
+
+class Scheduler;
 class DirectUringRandomAccessFile: public DirectRandomAccessFile {
 public:
 	explicit DirectUringRandomAccessFile(const std::string& file);
-	static void RegisterBuffer(std::vector<std::shared_ptr<ByteBuffer>> buffers);
-    static void RegisterBufferFromPool(std::vector<uint32_t> colIds);
+    // register the buffers of BufferPool that are not registered yet
+    static void RegisterBufferFromPool();
+	// the ring of a thread is created once and kept until the thread exits
 	static void Initialize();
 	static void Reset();
 	std::shared_ptr<ByteBuffer> readAsync(int length, std::shared_ptr<ByteBuffer> buffer, int index);
-	void readAsyncSubmit(int size);
+	/**
+	 * Submit the reads prepared by readAsync.
+	 * @param observer if not null, observes the time from submitting the reads to their completion
+	 */
+	void readAsyncSubmit(int size, Scheduler * observer = nullptr);
 	void readAsyncComplete(int size);
+	/**
+	 * Wait for all the submitted reads of this file, including those abandoned by an error, so
+	 * that the kernel no longer writes into their buffers. It does not throw.
+	 * @return false if the reads can't be waited for, then their buffers must not be reused
+	 */
+	bool drain();
+	void close() override;
 	~DirectUringRandomAccessFile();
 private:
+	// the reads of one submission, observed when the last of them completes
+	struct AsyncBatch {
+		Scheduler * observer;
+		std::chrono::steady_clock::time_point submitted;
+		int reads;
+		uint64_t bytes;
+		int remaining;
+	};
+	struct PendingRead {
+		DirectUringRandomAccessFile * file;
+		// the bytes at the head of the read that the caller needs, the rest may lie beyond the end of file
+		uint32_t required;
+		std::shared_ptr<AsyncBatch> batch;
+	};
+	/**
+	 * Reap the ready completions, or wait for one if none is ready.
+	 * @param waited set once the thread blocks for a completion, from then on a completion is
+	 * reaped soon after it arrives, so the time of its batch is observed
+	 * @return false if waiting fails
+	 */
+	static bool ReapCompletions(bool & waited);
+	void releaseFixedFile();
 	static thread_local struct io_uring * ring;
-	static thread_local bool isRegistered;
-	static thread_local struct iovec * iovecs;
-	static thread_local uint32_t iovecSize;
+	// the in-flight reads of the ring, keyed by the user_data of their submission
+	static thread_local std::unordered_map<uint64_t, PendingRead> pendingReads;
+	static thread_local uint64_t nextUserData;
+	static thread_local bool enableFixedFiles;
+	// the free entries of the registered file table
+	static thread_local std::vector<int> freeFileSlots;
+	// number of entries of the registered buffer table, the unused entries are sparse
+	static thread_local uint32_t registeredCapacity;
+	uint32_t completedReads = 0;
+	// the reads of this file in pendingReads
+	uint32_t inflightReads = 0;
+	// the user_data and the bytes of the reads prepared by readAsync and not submitted yet
+	std::vector<uint64_t> preparedReads;
+	uint64_t preparedBytes = 0;
+	// the last failed read of this file, reported by readAsyncComplete
+	std::string readError;
+	// the entry of fd in the registered file table of fixedFileRing, -1 if fd is not registered
+	int fixedFileIndex = -1;
+	struct io_uring * fixedFileRing = nullptr;
 };
 #endif // DUCKDB_DIRECTURINGRANDOMACCESSFILE_H
@@ -0,0 +1,39 @@
+//
+// Created by pixels on 10/18/26.
+//
+
+#ifndef DUCKDB_MMAPRANDOMACCESSFILE_H
+#define DUCKDB_MMAPRANDOMACCESSFILE_H
+
+#include "physical/natives/PixelsRandomAccessFile.h"
+#include "physical/natives/ByteBuffer.h"
+#include <string>
+
+/**
+ * The reads of localfs.io.mode=mmap.
+ *
+ * The file is mapped once when it is opened, and readFully returns a ByteBuffer that views
+ * the mapping instead of a copy, so that scans of files in the page cache copy nothing. The
+ * reuse buffer of readFully(len, bb) is ignored for the same reason. Each read advises the
+ * kernel to read its pages ahead. The views are valid until close() unmaps the file.
+ */
+class MmapRandomAccessFile: public PixelsRandomAccessFile {
+public:
+    explicit MmapRandomAccessFile(const std::string& file);
+    void close() override;
+    std::shared_ptr<ByteBuffer> readFully(int len) override;
+    std::shared_ptr<ByteBuffer> readFully(int len, std::shared_ptr<ByteBuffer> bb) override;
+    long length() override;
+    void seek(long off) override;
+    long readLong() override;
+    char readChar() override;
+    int readInt() override;
+    ~MmapRandomAccessFile();
+private:
+    // the deallocator of the views, which leaves the mapping to close()
+    static void keepMapping(uint8_t * address, uint32_t size);
+    uint8_t * mapping;
+    long len;
+    long offset;
+};
+#endif // DUCKDB_MMAPRANDOMACCESSFILE_H
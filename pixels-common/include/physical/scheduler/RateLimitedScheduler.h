@@ -0,0 +1,105 @@
+//
+// Created by pixels on 10/18/26.
+//
+
+#ifndef PIXELS_RATELIMITEDSCHEDULER_H
+#define PIXELS_RATELIMITEDSCHEDULER_H
+
+#include "physical/Scheduler.h"
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+/**
+ * Admits the read batches of concurrent queries under token-bucket limits of bandwidth
+ * and IOPS, both per device and per query, and then reads them as the noop scheduler does.
+ *
+ * A batch waits on its device while a batch of a higher priority class is waiting there,
+ * so interactive queries go ahead of normal ones, and normal ones ahead of background
+ * scans such as exports. A limit of 0 means unlimited.
+ */
+class RateLimitedScheduler : public Scheduler {
+public:
+    enum Priority {
+        INTERACTIVE = 0,
+        NORMAL = 1,
+        BACKGROUND = 2
+    };
+    static const int PRIORITY_NUM = 3;
+    struct Metrics {
+        // the batches waiting for tokens, per priority class
+        int queueDepth[PRIORITY_NUM];
+        // the batches being issued to the device, per priority class
+        int inFlight[PRIORITY_NUM];
+        // the batches and their bytes that were admitted, per priority class
+        uint64_t admittedBatches[PRIORITY_NUM];
+        uint64_t admittedBytes[PRIORITY_NUM];
+        // the total time that batches waited for tokens, per priority class
+        double throttledSeconds[PRIORITY_NUM];
+    };
+    static Scheduler * Instance();
+    /**
+     * @param priority interactive, normal or background
+     */
+    static Priority parsePriority(const std::string & priority);
+    static std::string priorityName(Priority priority);
+	std::vector<std::shared_ptr<ByteBuffer>> executeBatch(std::shared_ptr<PhysicalReader> reader, RequestBatch batch, long queryId) override;
+	std::vector<std::shared_ptr<ByteBuffer>> executeBatch(std::shared_ptr<PhysicalReader> reader, RequestBatch batch,
+	                                                      std::vector<std::shared_ptr<ByteBuffer>> reuseBuffers, long queryId) override;
+    /**
+     * Set the priority class of a query. Each scan of the query registers once and unregisters
+     * when it ends, the bucket of the query is dropped with its last scan. Unregistered queries
+     * run with the normal priority.
+     */
+    void registerQuery(long queryId, Priority priority);
+    void unregisterQuery(long queryId);
+    Metrics getMetrics();
+private:
+    RateLimitedScheduler();
+    struct TokenBucket {
+        double bytesPerSecond = 0;
+        double iops = 0;
+        // may go negative, a request larger than the burst is admitted and paid back over time
+        double byteTokens = 0;
+        double ioTokens = 0;
+        std::chrono::steady_clock::time_point last;
+        void init(double bytesPerSecond, double iops);
+        void refill(std::chrono::steady_clock::time_point now);
+        // the time until both kinds of tokens are non-negative
+        double waitSeconds() const;
+        void take(uint64_t bytes, int requests);
+    };
+    struct DeviceQueue {
+        std::mutex lock;
+        std::condition_variable available;
+        TokenBucket bucket;
+        int waiting[PRIORITY_NUM] = {0, 0, 0};
+    };
+    struct QueryState {
+        Priority priority = NORMAL;
+        int scans = 0;
+        TokenBucket bucket;
+    };
+    // the queue of the device of the file, which is resolved once per path by each thread
+    std::shared_ptr<DeviceQueue> getDeviceQueue(const std::string & path);
+    void acquireQueryTokens(long queryId, uint64_t bytes, int requests);
+    Priority getPriority(long queryId);
+    static Scheduler * instance;
+    double deviceBandwidth;
+    double deviceIops;
+    double queryBandwidth;
+    double queryIops;
+    std::mutex devicesLock;
+    std::map<uint64_t, std::shared_ptr<DeviceQueue>> devices;
+    // path -> the queue of its device, the queues are never dropped from devices
+    static thread_local std::unordered_map<std::string, std::shared_ptr<DeviceQueue>> deviceCache;
+    std::mutex queriesLock;
+    std::map<long, QueryState> queries;
+    std::mutex metricsLock;
+    Metrics metrics;
+};
+#endif //PIXELS_RATELIMITEDSCHEDULER_H
@@ -9,21 +9,48 @@
 #include "physical/MergedRequest.h"
 #include<algorithm>
 #include "exception/InvalidArgumentException.h"
-
+#include <atomic>
+#include <mutex>
+
+/**
+ * Coalesces the requests of a batch whose gap is within the merge gap into one large read,
+ * and splits the result back into the requested chunks without copying.
+ *
+ * With async io, the merged reads go to the registered buffers of BufferPool. If
+ * read.request.merge.gap.adaptive is set, the merge gap follows the cost of a request
+ * relative to the bandwidth of the device, both fitted from the observed reads. An async batch
+ * is observed from its submission to the completion of its last read, when the scan waits for it.
+ */
 class SortMergeScheduler : public Scheduler {
     // TODO: logger
 public:
     static Scheduler * Instance();
-	std::vector<std::shared_ptr<MergedRequest>> sortMerge(RequestBatch batch, long queryId);
+	/**
+	 * @param order filled with the indexes of the requests in the batch, in the order of
+	 * the sub-requests of the merged requests
+	 */
+	std::vector<std::shared_ptr<MergedRequest>> sortMerge(RequestBatch batch, long queryId, std::vector<int> & order);
 	std::vector<std::shared_ptr<ByteBuffer>> executeBatch(std::shared_ptr<PhysicalReader> reader,
 	                                                                          RequestBatch batch, long queryId) override;
 	std::vector<std::shared_ptr<ByteBuffer>> executeBatch(std::shared_ptr<PhysicalReader> reader, RequestBatch batch,
 	                                                      std::vector<std::shared_ptr<ByteBuffer>> reuseBuffers, long queryId) override;
-
+	void observe(int requests, uint64_t bytes, double seconds) override;
+	long getMergeGap();
 
 private:
     SortMergeScheduler();
     static Scheduler * instance;
+    std::atomic<long> mergeGap;
+    bool adaptive;
+    long maxMergeGap;
+    int fsBlockSize;
+    // decayed sums of the least squares fit of seconds = requests * requestCost + bytes * byteCost
+    std::mutex fitLock;
+    double sumRR = 0;
+    double sumRB = 0;
+    double sumBB = 0;
+    double sumRT = 0;
+    double sumBT = 0;
 
 
 };
@@ -10,6 +10,7 @@
 #include <string>
 #include <vector>
 #include <iostream>
+#include <atomic>
 /**
  * This implementation is used to access all kinds of POSIX file systems that are mounted
  * on a local directory. The file system does not need to be local physically. For example,
@@ -29,9 +30,43 @@ public:
     std::vector<std::string> listPaths(const std::string &path) override;
     std::ifstream open(const std::string &path) override;
     void close() override;
+    enum AsyncLib {
+        IOURING,
+        AIO
+    };
+    /**
+     * @return the lib of async reads, which is localfs.async.lib unless io_uring
+     * cannot be set up on this machine and aio is used instead
+     */
+    static AsyncLib getAsyncLib();
+    /**
+     * Set up the async reads of the calling thread, falling back to aio if io_uring fails.
+     */
+    static void initializeAsyncIo();
+    enum IoMode {
+        DIRECT,
+        MMAP
+    };
+    /**
+     * @return localfs.io.mode, i.e., whether files are read into buffers (direct) or viewed
+     * through a memory mapping (mmap)
+     */
+    static IoMode getIoMode();
+    /**
+     * @return true if localfs.enable.async.io is set and files are read into buffers
+     */
+    static bool isAsyncEnabled();
+    /**
+     * @return true if localfs.write.mode is direct, i.e., files are written with O_DIRECT
+     * bypassing the page cache, otherwise (buffered) they are written through the page cache
+     */
+    static bool isDirectWriteEnabled();
 private:
-    // TODO: read the configuration from pixels.properties for the following to values.
-    static bool MmapEnabled;
+    static std::atomic<bool> uringUnavailable;
+    // the lib set up by initializeAsyncIo on this thread, whose files are opened for it
+    static thread_local bool threadAsyncIoInitialized;
+    static thread_local AsyncLib threadAsyncLib;
+    // TODO: read the configuration from pixels.properties for the following value.
     static bool EnableCache;
     static std::string SchemePrefix;
     // TODO: the remaining function is needed to be implemented.
@@ -0,0 +1,60 @@
+//
+// Created by pixels on 10/18/26.
+//
+
+#ifndef PIXELS_PHYSICALDIRECTWRITER_H
+#define PIXELS_PHYSICALDIRECTWRITER_H
+
+#include "physical/PhysicalWriter.h"
+#include "physical/natives/DirectIoLib.h"
+#include <memory>
+#include <vector>
+
+/**
+ * Writes a local file with O_DIRECT, so that loading does not evict the pages of the files
+ * being queried.
+ *
+ * The appended content is staged in block aligned buffers. A full buffer is submitted to
+ * io_uring (or written by pwrite if io_uring is unavailable) and the next buffer is filled
+ * while up to localfs.write.queue.depth buffers are in flight. close() writes the last
+ * partial block, truncates the file to its real length and, if localfs.write.fdatasync is
+ * set, waits for the data to be durable.
+ */
+class PhysicalDirectWriter : public PhysicalWriter {
+public:
+    explicit PhysicalDirectWriter(const std::string &path);
+    ~PhysicalDirectWriter() override;
+    std::int64_t prepare(int length) override;
+    std::int64_t append(const uint8_t *buffer, int offset, int length) override;
+    std::int64_t append(std::shared_ptr<ByteBuffer> byteBuffer) override;
+    std::int64_t append(const std::vector<struct iovec> &buffers) override;
+    void close() override;
+    void flush() override;
+    std::string getPath() const override;
+    int getBufferSize() const override;
+private:
+    struct StagingBuffer {
+        std::shared_ptr<ByteBuffer> buffer;
+        bool inFlight = false;
+        std::int64_t fileOffset = 0;
+        int length = 0;
+    };
+    // submit the current buffer and move on to the next one
+    void submitCurrent();
+    // wait until the given buffer is no longer in flight
+    void waitFor(StagingBuffer &staging);
+    void reap(struct io_uring_cqe *cqe);
+    void writeFully(const uint8_t *buffer, int length, std::int64_t fileOffset);
+    std::string path;
+    int fd;
+    int blockSize;
+    int bufferSize;
+    std::int64_t position;
+    // the file offset of the start of the current buffer, always block aligned
+    std::int64_t bufferStart;
+    std::vector<StagingBuffer> buffers;
+    int current;
+    struct io_uring *ring;
+    int inFlight;
+};
+#endif //PIXELS_PHYSICALDIRECTWRITER_H
@@ -20,6 +20,8 @@ public:
 	void Print();
 	std::string getProperty(std::string key);
     bool boolCheckProperty(std::string key);
+	// add or replace a property after the properties file is loaded, e.g., by tests
+	void addProperty(std::string key, std::string value);
 	std::string getPixelsDirectory();
     std::string getPixelsSourceDirectory();
 private:
@@ -0,0 +1,39 @@
+//
+// Created by pixels on 10/18/26.
+//
+
+#ifndef DUCKDB_HUGEPAGEUTIL_H
+#define DUCKDB_HUGEPAGEUTIL_H
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Memory backed by 2MB pages for the direct buffers and the column vectors.
+ *
+ * If pixel.hugepage.enable is true, an allocation of at least one huge page is mapped with
+ * MAP_HUGETLB, and falls back to anonymous memory advised for transparent huge pages if the
+ * hugetlb pool has no free pages. Smaller allocations use posix_memalign as before.
+ */
+class HugePageUtil {
+public:
+    static const size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+    static bool isEnabled();
+    // whether an allocation of the size is mapped to huge pages, and must be freed by freeAligned
+    static bool isHugeAllocation(size_t size);
+    /**
+     * @param alignment the alignment of small allocations, huge allocations are aligned to the huge page
+     * @return the memory, or nullptr if it cannot be allocated
+     */
+    static void * allocateAligned(size_t alignment, size_t size);
+    // @param size the same size as the allocation
+    static void freeAligned(void * address, size_t size);
+    // the deallocator of ByteBuffer for the memory of allocateAligned
+    static void freeBuffer(uint8_t * address, uint32_t size);
+    // the hugetlb and transparent huge pages that the process maps, read from /proc/self/smaps_rollup
+    static uint64_t getHugePagesInUse();
+private:
+    static void * mapHugePages(size_t size);
+};
+
+#endif // DUCKDB_HUGEPAGEUTIL_H
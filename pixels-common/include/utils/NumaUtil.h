@@ -0,0 +1,34 @@
+//
+// Created by pixels on 10/18/26.
+//
+
+#ifndef DUCKDB_NUMAUTIL_H
+#define DUCKDB_NUMAUTIL_H
+
+#include <string>
+#include <cstddef>
+
+/**
+ * NUMA placement of the scan threads and their direct buffers.
+ *
+ * It takes effect only if localfs.numa.enable is true, pixels-common is built with libnuma
+ * (ENABLE_NUMA) and the host has more than one node. Otherwise every function is a no-op
+ * and every node is -1 (unknown).
+ */
+class NumaUtil {
+public:
+    static bool isEnabled();
+    /**
+     * @param path the path of a local file
+     * @return the node that the block device of the file is attached to, read from sysfs
+     */
+    static int getNodeOfFile(const std::string & path);
+    // the node of the cpu that the calling thread runs on
+    static int getCurrentNode();
+    // run the calling thread on the cpus of the node only, -1 lets it run on all the cpus again
+    static void runOnNode(int node);
+    // place the pages of the memory on the node, moving the pages that are already touched
+    static void bindMemory(void * address, size_t size, int node);
+};
+
+#endif // DUCKDB_NUMAUTIL_H
@@ -0,0 +1,44 @@
+//
+// Created by pixels on 10/18/26.
+//
+
+#ifndef DUCKDB_THREADPOOL_H
+#define DUCKDB_THREADPOOL_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * A fixed set of worker threads that run the submitted tasks in FIFO order.
+ *
+ * The workers live as long as the pool, so that short tasks, e.g., encoding the columns of
+ * one row batch, do not pay for creating and joining threads. Tasks must not wait for other
+ * tasks of the same pool.
+ */
+class ThreadPool {
+public:
+    /**
+     * @param threadNum the number of workers, 0 means the number of cpu cores
+     */
+    explicit ThreadPool(int threadNum);
+    ~ThreadPool();
+    /**
+     * @return the future of the task, which rethrows the exception of the task on get()
+     */
+    std::future<void> submit(std::function<void()> task);
+    int getThreadNum() const;
+private:
+    void work();
+    std::vector<std::thread> workers;
+    std::deque<std::packaged_task<void()>> tasks;
+    std::mutex lock;
+    std::condition_variable taskAdded;
+    bool stopped;
+};
+
+#endif // DUCKDB_THREADPOOL_H
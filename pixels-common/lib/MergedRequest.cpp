@@ -22,14 +22,14 @@ std::shared_ptr<MergedRequest> MergedRequest::merge(Request curr) {
         this->size++;
         return shared_from_this();
     }
-    return std::make_shared<MergedRequest>(curr);
+    return std::make_shared<MergedRequest>(curr, maxGap);
 }
 
-MergedRequest::MergedRequest(Request first) {
+MergedRequest::MergedRequest(Request first, long maxGap) {
     this->queryId = first.queryId;
     this->start = first.start;
     this->end = first.start + first.length;
-    this->maxGap = std::stoi(ConfigFactory::Instance().getProperty("read.request.merge.gap"));
+    this->maxGap = maxGap;
     this->offsets.emplace_back(0);
     this->lengths.emplace_back(first.length);
     this->length = first.length;
@@ -5,79 +5,284 @@
 #include "physical/BufferPool.h"
 
 thread_local int BufferPool::colCount = 0;
-thread_local std::map<uint32_t, uint64_t> BufferPool::nrBytes;
-thread_local bool BufferPool::isInitialized = false;
-thread_local std::map<uint32_t, std::shared_ptr<ByteBuffer>> BufferPool::buffers[2];
-// The currBufferIdx is set to 1. When executing the first file, this value is 0
+thread_local std::map<uint32_t, uint32_t> BufferPool::slotIds[2];
+thread_local std::vector<uint32_t> BufferPool::mergedSlotIds[2];
+thread_local std::vector<std::shared_ptr<ByteBuffer>> BufferPool::arena;
+thread_local std::vector<int> BufferPool::arenaSizeClass;
+thread_local std::vector<int> BufferPool::arenaNode;
+thread_local int BufferPool::numaNode = -1;
+thread_local std::vector<uint32_t> BufferPool::emptySlots;
+thread_local std::map<int, std::vector<uint32_t>> BufferPool::freeLists;
+thread_local std::vector<uint32_t> BufferPool::dirtySlots;
+// The currBufferIdx is set to 1. When the first file is prefetched, this value is 0
 // since we call switch function first.
 thread_local int BufferPool::currBufferIdx = 1;
 thread_local int BufferPool::nextBufferIdx = 0;
-std::shared_ptr<DirectIoLib> BufferPool::directIoLib;
+thread_local std::shared_ptr<DirectIoLib> BufferPool::directIoLib;
+thread_local int BufferPool::fsBlockSize = 0;
+std::atomic<uint64_t> BufferPool::totalBytes{0};
+std::atomic<uint64_t> BufferPool::heldBytes{0};
+thread_local uint64_t BufferPool::threadHeldBytes = 0;
+std::atomic<uint64_t> BufferPool::budgetLimit{0};
+std::mutex BufferPool::budgetLock;
+std::condition_variable BufferPool::budgetReleased;
+int BufferPool::holdingThreads = 0;
+int BufferPool::waitingHolders = 0;
+
+// the smallest size class is 64KB
+#define MIN_SIZE_CLASS 16
+
+uint64_t BufferPool::GetMaxBytes() {
+	static uint64_t maxBytes = std::stoull(ConfigFactory::Instance().getProperty("pixel.bufferpool.max.size"));
+	return maxBytes;
+}
+
+uint64_t BufferPool::GetBudget() {
+	uint64_t maxBytes = GetMaxBytes();
+	uint64_t limit = budgetLimit;
+	if(limit == 0 || maxBytes == 0) {
+		return std::max(limit, maxBytes);
+	}
+	return std::min(limit, maxBytes);
+}
+
+void BufferPool::LimitBudget(uint64_t bytes) {
+	budgetLimit = bytes;
+	// waiters may fit in a larger budget
+	std::lock_guard<std::mutex> lock(budgetLock);
+	budgetReleased.notify_all();
+}
+
+void BufferPool::InitializeDirectIoLib() {
+	if(directIoLib == nullptr) {
+		fsBlockSize = std::stoi(ConfigFactory::Instance().getProperty("localfs.block.size"));
+		directIoLib = std::make_shared<DirectIoLib>(fsBlockSize);
+		directIoLib->setNumaNode(numaNode);
+	}
+}
+
+void BufferPool::SetNumaNode(int node) {
+	InitializeDirectIoLib();
+	numaNode = node;
+	directIoLib->setNumaNode(node);
+}
 
 void BufferPool::Initialize(std::vector<uint32_t> colIds, std::vector<uint64_t> bytes, std::vector<std::string> columnNames) {
 	assert(colIds.size() == bytes.size());
-	int fsBlockSize = std::stoi(ConfigFactory::Instance().getProperty("localfs.block.size"));
-    std::string columnSizePath = ConfigFactory::Instance().getProperty("pixel.column.size.path");
-    std::shared_ptr<ColumnSizeCSVReader> csvReader;
-    if (!columnSizePath.empty()) {
-        csvReader = std::make_shared<ColumnSizeCSVReader>(columnSizePath);
-    }
+	InitializeDirectIoLib();
 
-    // give the maximal column size, which is stored in csv reader
-	if(!BufferPool::isInitialized) {
-        currBufferIdx = 0;
-        nextBufferIdx = 1;
-		directIoLib = std::make_shared<DirectIoLib>(fsBlockSize);
+	// the buffers of the other file are assigned only when the scan prefetches into them
+	auto & slots = BufferPool::slotIds[currBufferIdx];
+	if(slots.empty()) {
+        std::string columnSizePath = ConfigFactory::Instance().getProperty("pixel.column.size.path");
+        std::shared_ptr<ColumnSizeCSVReader> csvReader;
+        if (!columnSizePath.empty()) {
+            csvReader = std::make_shared<ColumnSizeCSVReader>(columnSizePath);
+        }
 		for(int i = 0; i < colIds.size(); i++) {
 			uint32_t colId = colIds.at(i);
-            std::string columnName = columnNames[colId];
-            for(int idx = 0; idx < 2; idx++) {
-                std::shared_ptr<ByteBuffer> buffer;
-                if (columnSizePath.empty()) {
-                    buffer = BufferPool::directIoLib->allocateDirectBuffer(bytes.at(i) + EXTRA_POOL_SIZE);
-                } else {
-                    buffer = BufferPool::directIoLib->allocateDirectBuffer(csvReader->get(columnName));
-                }
-
-                BufferPool::nrBytes[colId] = buffer->size();
-                BufferPool::buffers[idx][colId] = buffer;
+            uint64_t size = bytes.at(i);
+            if (csvReader != nullptr) {
+                // the maximal column size given by the csv reader
+                size = std::max(size, (uint64_t)csvReader->get(columnNames[colId]));
             }
+            slots[colId] = AcquireSlot(size);
 		}
 		BufferPool::colCount = colIds.size();
-		BufferPool::isInitialized = true;
 	} else {
 		// check if resize the buffer is needed
 		assert(colIds.size() == BufferPool::colCount);
 		for (int i = 0; i < colIds.size(); i++) {
 			uint32_t colId = colIds.at(i);
-			uint64_t byte = bytes.at(i);
-            std::string columnName = columnNames[colId];
-			if (BufferPool::nrBytes.find(colId) == BufferPool::nrBytes.end()) {
+			auto slot = slots.find(colId);
+			if (slot == slots.end()) {
 				throw InvalidArgumentException("BufferPool::Initialize: no such the column id.");
 			}
-			// Note: this code should never happen in the pixels scenario
-			if (BufferPool::nrBytes[colId] < byte) {
-				throw InvalidArgumentException("the new buffer byte cannot larger than the previous buffer byte. ");
+			// the buffer of the current file is not in use, so it can be swapped for a larger one.
+			// It is released first so that the swap only waits for the extra bytes
+			if (arenaSizeClass.at(slot->second) < SizeClassOf(bytes.at(i))) {
+				ReleaseSlot(slot->second);
+				slot->second = AcquireSlot(bytes.at(i));
 			}
 		}
 	}
 }
 
-int64_t BufferPool::GetBufferId(uint32_t index) {
-    return index + currBufferIdx * colCount;
+int BufferPool::SizeClassOf(uint64_t length) {
+	// a direct read may start one block before the data and end in the block after it
+	uint64_t size = directIoLib->blockEnd((long)length) + fsBlockSize;
+	int sizeClass = MIN_SIZE_CLASS;
+	while(((uint64_t)1 << sizeClass) < size) {
+		sizeClass++;
+	}
+	return sizeClass;
+}
+
+uint32_t BufferPool::AcquireSlot(uint64_t length) {
+	int sizeClass = SizeClassOf(length);
+	uint64_t size = (uint64_t)1 << sizeClass;
+	Reserve(size);
+	auto & freeList = freeLists[sizeClass];
+	for(auto it = freeList.rbegin(); it != freeList.rend(); it++) {
+		if(numaNode < 0 || arenaNode.at(*it) == numaNode) {
+			uint32_t slot = *it;
+			freeList.erase(std::next(it).base());
+			return slot;
+		}
+	}
+	uint64_t maxBytes = GetBudget();
+	if(maxBytes > 0 && totalBytes + size > maxBytes) {
+		TrimFreeBuffers(maxBytes - std::min(maxBytes, size));
+	}
+	uint32_t slot;
+	if(!emptySlots.empty()) {
+		slot = emptySlots.back();
+		emptySlots.pop_back();
+	} else {
+		slot = arena.size();
+		arena.emplace_back(nullptr);
+		arenaSizeClass.emplace_back(0);
+		arenaNode.emplace_back(-1);
+	}
+	// allocateDirectBuffer adds one block to the size, so the buffer is exactly of the size class
+	arena.at(slot) = directIoLib->allocateDirectBuffer((long)(size - fsBlockSize));
+	arenaSizeClass.at(slot) = sizeClass;
+	arenaNode.at(slot) = numaNode;
+	totalBytes += size;
+	dirtySlots.emplace_back(slot);
+	return slot;
+}
+
+void BufferPool::ReleaseSlot(uint32_t slot) {
+	freeLists[arenaSizeClass.at(slot)].emplace_back(slot);
+	Unreserve((uint64_t)1 << arenaSizeClass.at(slot));
+}
+
+void BufferPool::Reserve(uint64_t bytes) {
+	std::unique_lock<std::mutex> lock(budgetLock);
+	bool holding = threadHeldBytes > 0;
+	uint64_t limit = GetBudget();
+	while(limit > 0 && heldBytes + bytes > limit) {
+		// wait only if another holder is still running and will release its buffers,
+		// otherwise all the holders would wait for each other
+		int releasers = holdingThreads - waitingHolders - (holding ? 1 : 0);
+		if(releasers <= 0) {
+			break;
+		}
+		if(holding) {
+			waitingHolders++;
+		}
+		budgetReleased.wait(lock);
+		if(holding) {
+			waitingHolders--;
+		}
+		limit = GetBudget();
+	}
+	heldBytes += bytes;
+	threadHeldBytes += bytes;
+	if(!holding) {
+		holdingThreads++;
+	}
+}
+
+void BufferPool::Unreserve(uint64_t bytes) {
+	std::lock_guard<std::mutex> lock(budgetLock);
+	heldBytes -= bytes;
+	threadHeldBytes -= bytes;
+	if(threadHeldBytes == 0) {
+		holdingThreads--;
+	}
+	budgetReleased.notify_all();
+}
+
+bool BufferPool::ShouldPrefetch() {
+	uint64_t limit = GetBudget();
+	// the buffers of the other file are still assigned from the last prefetch
+	if(limit == 0 || !slotIds[1 - currBufferIdx].empty()) {
+		return true;
+	}
+	// the next file needs about as many bytes as this thread holds for the current one
+	return heldBytes + threadHeldBytes <= limit;
+}
+
+void BufferPool::TrimFreeBuffers(uint64_t budget) {
+	for(auto freeList = freeLists.rbegin(); freeList != freeLists.rend() && totalBytes > budget; freeList++) {
+		while(!freeList->second.empty() && totalBytes > budget) {
+			uint32_t slot = freeList->second.back();
+			freeList->second.pop_back();
+			arena.at(slot) = nullptr;
+			totalBytes -= (uint64_t)1 << arenaSizeClass.at(slot);
+			arenaSizeClass.at(slot) = 0;
+			emptySlots.emplace_back(slot);
+			dirtySlots.emplace_back(slot);
+		}
+	}
+}
+
+uint64_t BufferPool::GetTotalBytes() {
+	return totalBytes;
+}
+
+uint64_t BufferPool::GetHeldBytes() {
+	return heldBytes;
+}
+
+std::shared_ptr<ByteBuffer> BufferPool::GetMergedBuffer(uint32_t index, uint64_t size, int64_t & bufferId) {
+	InitializeDirectIoLib();
+	auto & mergedSlots = BufferPool::mergedSlotIds[currBufferIdx];
+	if(index >= mergedSlots.size()) {
+		mergedSlots.emplace_back(AcquireSlot(size));
+	} else if(arenaSizeClass.at(mergedSlots.at(index)) < SizeClassOf(size)) {
+		// the buffer is too small, swap it for a larger one
+		ReleaseSlot(mergedSlots.at(index));
+		mergedSlots.at(index) = AcquireSlot(size);
+	}
+	bufferId = mergedSlots.at(index);
+	return arena.at(bufferId);
+}
+
+int64_t BufferPool::GetBufferId(uint32_t colId) {
+    return BufferPool::slotIds[currBufferIdx].at(colId);
 }
 
 std::shared_ptr<ByteBuffer> BufferPool::GetBuffer(uint32_t colId) {
-	return BufferPool::buffers[currBufferIdx][colId];
+	return BufferPool::arena.at(BufferPool::slotIds[currBufferIdx].at(colId));
 }
 
 void BufferPool::Reset() {
-	BufferPool::isInitialized = false;
-	BufferPool::nrBytes.clear();
     for(int idx = 0; idx < 2; idx++) {
-        BufferPool::buffers[idx].clear();
+        for(auto & slot : BufferPool::slotIds[idx]) {
+            ReleaseSlot(slot.second);
+        }
+        for(auto slot : BufferPool::mergedSlotIds[idx]) {
+            ReleaseSlot(slot);
+        }
+        BufferPool::slotIds[idx].clear();
+        BufferPool::mergedSlotIds[idx].clear();
     }
 	BufferPool::colCount = 0;
+	uint64_t maxBytes = GetBudget();
+	if(maxBytes > 0 && totalBytes > maxBytes) {
+		TrimFreeBuffers(maxBytes);
+	}
+}
+
+void BufferPool::Abandon() {
+	uint64_t bytes = 0;
+	for(int idx = 0; idx < 2; idx++) {
+		for(auto & slot : BufferPool::slotIds[idx]) {
+			bytes += (uint64_t)1 << arenaSizeClass.at(slot.second);
+		}
+		for(auto slot : BufferPool::mergedSlotIds[idx]) {
+			bytes += (uint64_t)1 << arenaSizeClass.at(slot);
+		}
+		BufferPool::slotIds[idx].clear();
+		BufferPool::mergedSlotIds[idx].clear();
+	}
+	BufferPool::colCount = 0;
+	if(bytes > 0) {
+		Unreserve(bytes);
+	}
 }
 
 void BufferPool::Switch() {
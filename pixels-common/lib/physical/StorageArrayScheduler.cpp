@@ -2,6 +2,7 @@
 // Created by liyu on 1/21/24.
 //
 #include "physical/StorageArrayScheduler.h"
+#include "utils/NumaUtil.h"
 
 
 StorageArrayScheduler::StorageArrayScheduler(std::vector<std::string> &files, int threadNum) {
@@ -42,17 +43,36 @@ StorageArrayScheduler::StorageArrayScheduler(std::vector<std::string> &files, in
                                        " , and the storage device num is " + std::to_string(devicesNum) +
                                        ". Otherwise the load balancing issue occurs. ");
     }
+    // the files of a device are on the same disk, so the first file tells the node of the device
+    for (auto& deviceFiles: filesVector) {
+        deviceNodes.emplace_back(NumaUtil::getNodeOfFile(deviceFiles.front()));
+    }
+    deviceThreads.assign(devicesNum, 0);
     currentDeviceID = 0;
 }
 
-int StorageArrayScheduler::acquireDeviceId() {
+int StorageArrayScheduler::acquireDeviceId(int preferredNode) {
     m.lock();
+    // without a preferred node, this is round robin
     int deviceId = currentDeviceID;
-    currentDeviceID = (currentDeviceID + 1) % devicesNum;
+    for (int i = 1; i < devicesNum; i++) {
+        int id = (currentDeviceID + i) % devicesNum;
+        if (deviceThreads[id] < deviceThreads[deviceId] ||
+            (deviceThreads[id] == deviceThreads[deviceId] && preferredNode >= 0 &&
+             deviceNodes[id] == preferredNode && deviceNodes[deviceId] != preferredNode)) {
+            deviceId = id;
+        }
+    }
+    deviceThreads[deviceId]++;
+    currentDeviceID = (deviceId + 1) % devicesNum;
     m.unlock();
     return deviceId;
 }
 
+int StorageArrayScheduler::getDeviceNode(int deviceID) {
+    return deviceNodes.at(deviceID);
+}
+
 int StorageArrayScheduler::getDeviceSum() {
     return devicesNum;
 }
@@ -19,6 +19,8 @@ PhysicalLocalReader::PhysicalLocalReader(std::shared_ptr<Storage> storage, std::
     }
     path = std::move(path_);
     raf = local->openRaf(path);
+    uringRaf = std::dynamic_pointer_cast<DirectUringRandomAccessFile>(raf);
+    aioRaf = std::dynamic_pointer_cast<DirectAioRandomAccessFile>(raf);
     // TODO: get fileid.
     numRequests = 1;
 	asyncNumRequests = 0;
@@ -68,54 +70,63 @@ std::string PhysicalLocalReader::getName() {
     return path.substr(path.find_last_of('/') + 1);
 }
 
+std::string PhysicalLocalReader::getPath() {
+    return path;
+}
+
 std::shared_ptr<ByteBuffer> PhysicalLocalReader::readAsync(int length, std::shared_ptr<ByteBuffer> buffer, int index) {
 	numRequests++;
-	if(ConfigFactory::Instance().getProperty("localfs.async.lib") == "iouring") {
-		auto directRaf = std::static_pointer_cast<DirectUringRandomAccessFile>(raf);
-		return directRaf->readAsync(length, std::move(buffer), index);
-	} else if(ConfigFactory::Instance().getProperty("localfs.async.lib") == "aio") {
-		throw InvalidArgumentException("PhysicalLocalReader::readAsync: We don't support aio for our async read yet.");
-	} else {
-		throw InvalidArgumentException("PhysicalLocalReader::readAsync: the async read method is unknown. ");
+	if(uringRaf != nullptr) {
+		return uringRaf->readAsync(length, std::move(buffer), index);
+	} else if(aioRaf != nullptr) {
+		return aioRaf->readAsync(length, std::move(buffer), index);
 	}
+	throw InvalidArgumentException("PhysicalLocalReader::readAsync: " + path + " is not opened for async reads");
 
 }
 
-void PhysicalLocalReader::readAsyncSubmit(uint32_t size) {
+void PhysicalLocalReader::readAsyncSubmit(uint32_t size, Scheduler * observer) {
 	numRequests++;
-	if(ConfigFactory::Instance().getProperty("localfs.async.lib") == "iouring") {
-		auto directRaf = std::static_pointer_cast<DirectUringRandomAccessFile>(raf);
-		directRaf->readAsyncSubmit(size);
-	} else if(ConfigFactory::Instance().getProperty("localfs.async.lib") == "aio") {
-		throw InvalidArgumentException("PhysicalLocalReader::readAsync: We don't support aio for our async read yet.");
+	asyncNumRequests += size;
+	if(uringRaf != nullptr) {
+		uringRaf->readAsyncSubmit(size, observer);
+	} else if(aioRaf != nullptr) {
+		aioRaf->readAsyncSubmit(size, observer);
 	} else {
-		throw InvalidArgumentException("PhysicalLocalReader::readAsync: the async read method is unknown. ");
+		throw InvalidArgumentException("PhysicalLocalReader::readAsyncSubmit: " + path + " is not opened for async reads");
 	}
 }
 
 void PhysicalLocalReader::readAsyncComplete(uint32_t size) {
 	numRequests++;
-	if(ConfigFactory::Instance().getProperty("localfs.async.lib") == "iouring") {
-		auto directRaf = std::static_pointer_cast<DirectUringRandomAccessFile>(raf);
-		directRaf->readAsyncComplete(size);
-	} else if(ConfigFactory::Instance().getProperty("localfs.async.lib") == "aio") {
-		throw InvalidArgumentException("PhysicalLocalReader::readAsync: We don't support aio for our async read yet.");
+	if(uringRaf != nullptr) {
+		uringRaf->readAsyncComplete(size);
+	} else if(aioRaf != nullptr) {
+		aioRaf->readAsyncComplete(size);
 	} else {
-		throw InvalidArgumentException("PhysicalLocalReader::readAsync: the async read method is unknown. ");
+		throw InvalidArgumentException("PhysicalLocalReader::readAsyncComplete: " + path + " is not opened for async reads");
 	}
+	asyncNumRequests -= size;
 }
 
-void PhysicalLocalReader::readAsyncSubmitAndComplete(uint32_t size){
-	numRequests++;
-	if(ConfigFactory::Instance().getProperty("localfs.async.lib") == "iouring") {
-		auto directRaf = std::static_pointer_cast<DirectUringRandomAccessFile>(raf);
-		directRaf->readAsyncSubmit(size);
-		::TimeProfiler::Instance().Start("async wait");
-		directRaf->readAsyncComplete(size);
-		::TimeProfiler::Instance().End("async wait");
-	} else if(ConfigFactory::Instance().getProperty("localfs.async.lib") == "aio") {
-		throw InvalidArgumentException("PhysicalLocalReader::readAsync: We don't support aio for our async read yet.");
-	} else {
-		throw InvalidArgumentException("PhysicalLocalReader::readAsync: the async read method is unknown. ");
+bool PhysicalLocalReader::readAsyncDrain() {
+	bool drained = true;
+	if(uringRaf != nullptr) {
+		drained = uringRaf->drain();
+	} else if(aioRaf != nullptr) {
+		drained = aioRaf->drain();
 	}
+	asyncNumRequests = 0;
+	return drained;
+}
+
+int PhysicalLocalReader::getAsyncNumRequests() {
+	return asyncNumRequests;
+}
+
+void PhysicalLocalReader::readAsyncSubmitAndComplete(uint32_t size){
+	readAsyncSubmit(size);
+	::TimeProfiler::Instance().Start("async wait");
+	readAsyncComplete(size);
+	::TimeProfiler::Instance().End("async wait");
 }
@@ -14,6 +14,7 @@
  Modfied 2015 by Ashley Davis (SgtCoDFish)
  */
 
+#include <algorithm>
 #include <utility>
 
 #include "physical/natives/ByteBuffer.h"
@@ -33,6 +34,7 @@ ByteBuffer::ByteBuffer(uint32_t size) {
     name = "";
     fromOtherBB = false;
 	allocated_by_new = true;
+	deallocator = nullptr;
     rmark = 0;
     wpos = 0;
     rpos = 0;
@@ -53,7 +55,17 @@ ByteBuffer::ByteBuffer(uint8_t * arr, uint32_t size, bool allocated_by_new) {
     name = "";
     fromOtherBB = false;
 	this->allocated_by_new = allocated_by_new;
+	deallocator = nullptr;
+}
 
+ByteBuffer::ByteBuffer(uint8_t * arr, uint32_t size, void (*deallocator)(uint8_t *, uint32_t)) {
+    buf = arr;
+    bufSize = size;
+    resetPosition();
+    name = "";
+    fromOtherBB = false;
+	allocated_by_new = false;
+	this->deallocator = deallocator;
 }
 
 ByteBuffer::ByteBuffer(ByteBuffer & bb, uint32_t startId, uint32_t length) {
@@ -64,6 +76,7 @@ ByteBuffer::ByteBuffer(ByteBuffer & bb, uint32_t startId, uint32_t length) {
     name = "";
     fromOtherBB = true;
 	allocated_by_new = true;
+	deallocator = nullptr;
 }
 
 /**
@@ -90,7 +103,9 @@ void ByteBuffer::clear() {
     resetPosition();
 	if(!fromOtherBB) {
 		if(buf != nullptr) {
-			if(allocated_by_new) {
+			if(deallocator != nullptr) {
+				deallocator(buf, bufSize);
+			} else if(allocated_by_new) {
 				delete[] buf;
 			} else {
 				free(buf);
@@ -201,9 +216,7 @@ int ByteBuffer::read(uint8_t * buffer, uint32_t off, uint32_t len) {
 // Write Functions
 
 void ByteBuffer::put(ByteBuffer* src) {
-    uint32_t len = src->size();
-    for (uint32_t i = 0; i < len; i++)
-        append<uint8_t>(src->get(i));
+    putBytes(src->getPointer(), src->size());
 }
 
 void ByteBuffer::put(uint8_t b) {
@@ -215,17 +228,46 @@ void ByteBuffer::put(uint8_t b, uint32_t index) {
 }
 
 void ByteBuffer::putBytes(uint8_t* b, uint32_t len) {
-    // Insert the data one byte at a time into the internal buffer at position i+starting index
-    for (uint32_t i = 0; i < len; i++)
-        append<uint8_t>(b[i]);
+    if (size() < wpos + len) {
+        ensureCapacity(wpos + len);
+    }
+    if (len > 0) {
+        memcpy(buf + wpos, b, len);
+    }
+    wpos += len;
 }
 
 void ByteBuffer::putBytes(uint8_t* b, uint32_t len, uint32_t index) {
     wpos = index;
+    putBytes(b, len);
+}
+
+void ByteBuffer::reserve(uint32_t len) {
+    ensureCapacity(wpos + len);
+}
 
-    // Insert the data one byte at a time into the internal buffer at position i+starting index
-    for (uint32_t i = 0; i < len; i++)
-        append<uint8_t>(b[i]);
+void ByteBuffer::ensureCapacity(uint32_t required) {
+    if (required <= bufSize) {
+        return;
+    }
+    // views of other buffers and buffers freed by others can not be reallocated
+    if (fromOtherBB || deallocator != nullptr) {
+        throw std::runtime_error("Append exceeds the size of buffer");
+    }
+    uint64_t newSize = std::max<uint64_t>((uint64_t) bufSize * 2, BB_DEFAULT_SIZE);
+    newSize = std::min<uint64_t>(std::max<uint64_t>(newSize, required), UINT32_MAX);
+    uint8_t * newBuf = new uint8_t[newSize];
+    if (buf != nullptr) {
+        memcpy(newBuf, buf, bufSize);
+        if (allocated_by_new) {
+            delete[] buf;
+        } else {
+            free(buf);
+        }
+    }
+    buf = newBuf;
+    bufSize = newSize;
+    allocated_by_new = true;
 }
 
 void ByteBuffer::putChar(char value) {
@@ -336,7 +378,9 @@ void ByteBuffer::printPosition() {
 ByteBuffer::~ByteBuffer() {
     if(!fromOtherBB) {
 		if(buf != nullptr) {
-			if(allocated_by_new) {
+			if(deallocator != nullptr) {
+				deallocator(buf, bufSize);
+			} else if(allocated_by_new) {
 				delete[] buf;
 			} else {
 				free(buf);
@@ -0,0 +1,244 @@
+//
+// Created by pixels on 10/18/26.
+//
+#include "physical/natives/DirectAioRandomAccessFile.h"
+#include "physical/Scheduler.h"
+#include <cerrno>
+#include <cstring>
+#include <sys/syscall.h>
+
+thread_local aio_context_t DirectAioRandomAccessFile::context = 0;
+thread_local std::vector<struct iocb> DirectAioRandomAccessFile::unsubmitted;
+thread_local std::unordered_map<uint64_t, DirectAioRandomAccessFile::PendingRead> DirectAioRandomAccessFile::pendingReads;
+thread_local uint64_t DirectAioRandomAccessFile::nextUserData = 0;
+
+#define AIO_QUEUE_DEPTH 4096
+#define COMPLETION_BATCH 64
+
+// glibc has no wrappers of the aio syscalls, and libaio is not needed for these few calls
+static int aioSetup(unsigned nrEvents, aio_context_t * ctx) {
+	return (int)syscall(__NR_io_setup, nrEvents, ctx);
+}
+
+static int aioDestroy(aio_context_t ctx) {
+	return (int)syscall(__NR_io_destroy, ctx);
+}
+
+static int aioSubmit(aio_context_t ctx, long nr, struct iocb ** iocbs) {
+	return (int)syscall(__NR_io_submit, ctx, nr, iocbs);
+}
+
+static int aioGetEvents(aio_context_t ctx, long minNr, long nr, struct io_event * events) {
+	return (int)syscall(__NR_io_getevents, ctx, minNr, nr, events, nullptr);
+}
+
+namespace {
+// destroys the aio context of a thread when the thread exits
+struct AioThreadGuard {
+	~AioThreadGuard() {
+		DirectAioRandomAccessFile::Reset();
+	}
+};
+thread_local AioThreadGuard aioThreadGuard;
+}
+
+DirectAioRandomAccessFile::DirectAioRandomAccessFile(const std::string &file) : DirectRandomAccessFile(file) {
+
+}
+
+void DirectAioRandomAccessFile::Initialize() {
+	if(context == 0) {
+		if(aioSetup(AIO_QUEUE_DEPTH, &context) != 0) {
+			context = 0;
+			throw InvalidArgumentException("DirectAioRandomAccessFile: initialize aio fails: " +
+			                               std::string(strerror(errno)));
+		}
+		(void)&aioThreadGuard;
+	}
+}
+
+void DirectAioRandomAccessFile::Reset() {
+	if(context != 0) {
+		aioDestroy(context);
+		context = 0;
+		unsubmitted.clear();
+		pendingReads.clear();
+	}
+}
+
+DirectAioRandomAccessFile::~DirectAioRandomAccessFile() {
+	// the context outlives the file, and the kernel may still write into the buffers of reads
+	// abandoned by an error
+	if(!drain()) {
+		std::cerr << "DirectAioRandomAccessFile: failed to drain the pending reads, "
+		          << "their buffers are not reused" << std::endl;
+		::BufferPool::Abandon();
+		for(auto it = pendingReads.begin(); it != pendingReads.end();) {
+			if(it->second.file == this) {
+				it = pendingReads.erase(it);
+			} else {
+				it++;
+			}
+		}
+	}
+}
+
+bool DirectAioRandomAccessFile::drain() {
+	// the reads of this file that are not submitted will never complete
+	for(auto it = unsubmitted.begin(); it != unsubmitted.end();) {
+		auto pending = pendingReads.find(it->aio_data);
+		if(pending != pendingReads.end() && pending->second.file == this) {
+			pendingReads.erase(pending);
+			inflightReads--;
+			it = unsubmitted.erase(it);
+		} else {
+			it++;
+		}
+	}
+	preparedReads.clear();
+	preparedBytes = 0;
+	bool waited = false;
+	while(inflightReads > 0) {
+		if(context == 0 || !ReapCompletions(waited)) {
+			return false;
+		}
+	}
+	// the reads were not waited for by readAsyncComplete, so neither are their errors reported
+	completedReads = 0;
+	readError.clear();
+	return true;
+}
+
+std::shared_ptr<ByteBuffer> DirectAioRandomAccessFile::readAsync(int length, std::shared_ptr<ByteBuffer> buffer, int index) {
+	struct iocb request{};
+	request.aio_fildes = fd;
+	request.aio_lio_opcode = IOCB_CMD_PREAD;
+	request.aio_buf = (uint64_t)buffer->getPointer();
+	std::shared_ptr<ByteBuffer> result;
+	uint32_t required;
+	if(enableDirect) {
+		// the file will be read from blockStart(fileOffset), and the first fileDelta bytes should be ignored.
+		uint64_t fileOffsetAligned = directIoLib->blockStart(offset);
+		request.aio_nbytes = directIoLib->blockEnd(offset + length) - fileOffsetAligned;
+		request.aio_offset = fileOffsetAligned;
+		result = std::make_shared<ByteBuffer>(*buffer, offset - fileOffsetAligned, length);
+		required = offset + length - fileOffsetAligned;
+	} else {
+		request.aio_nbytes = length;
+		request.aio_offset = offset;
+		result = std::make_shared<ByteBuffer>(*buffer, 0, length);
+		required = length;
+	}
+	request.aio_data = nextUserData;
+	preparedReads.emplace_back(nextUserData);
+	preparedBytes += request.aio_nbytes;
+	pendingReads[nextUserData++] = PendingRead{this, required, nullptr};
+	inflightReads++;
+	unsubmitted.emplace_back(request);
+	seek(offset + length);
+	return result;
+}
+
+void DirectAioRandomAccessFile::readAsyncSubmit(int size, Scheduler * observer) {
+	if(unsubmitted.size() != size) {
+		throw InvalidArgumentException("DirectAioRandomAccessFile::readAsyncSubmit: submit fails");
+	}
+	if(observer != nullptr && !preparedReads.empty()) {
+		auto batch = std::make_shared<AsyncBatch>(AsyncBatch{observer, std::chrono::steady_clock::now(),
+		                                                     (int)preparedReads.size(), preparedBytes,
+		                                                     (int)preparedReads.size()});
+		for(auto userData : preparedReads) {
+			pendingReads.at(userData).batch = batch;
+		}
+	}
+	preparedReads.clear();
+	preparedBytes = 0;
+	std::vector<struct iocb *> requests(unsubmitted.size());
+	for(int i = 0; i < unsubmitted.size(); i++) {
+		requests[i] = &unsubmitted[i];
+	}
+	// io_submit may take only a part of the requests
+	long submitted = 0;
+	while(submitted < (long)requests.size()) {
+		int ret = aioSubmit(context, (long)requests.size() - submitted, requests.data() + submitted);
+		if(ret < 0 && errno == EINTR) {
+			continue;
+		}
+		if(ret <= 0) {
+			// the rest of the batch is not in flight, the submitted reads are drained later
+			for(long i = submitted; i < (long)requests.size(); i++) {
+				auto pending = pendingReads.find(requests[i]->aio_data);
+				if(pending != pendingReads.end()) {
+					pending->second.file->inflightReads--;
+					pendingReads.erase(pending);
+				}
+			}
+			unsubmitted.clear();
+			throw InvalidArgumentException("DirectAioRandomAccessFile::readAsyncSubmit: submit fails: " +
+			                               std::string(strerror(ret < 0 ? errno : EAGAIN)));
+		}
+		submitted += ret;
+	}
+	unsubmitted.clear();
+}
+
+void DirectAioRandomAccessFile::readAsyncComplete(int size) {
+	// completions of other files on this context are credited to their own files
+	bool waited = false;
+	while(completedReads < size) {
+		if(!ReapCompletions(waited)) {
+			throw InvalidArgumentException("DirectAioRandomAccessFile::readAsyncComplete: get events fails: " +
+			                               std::string(strerror(errno)));
+		}
+	}
+	completedReads -= size;
+	if(!readError.empty()) {
+		std::string error = std::move(readError);
+		readError.clear();
+		throw InvalidArgumentException("DirectAioRandomAccessFile::readAsyncComplete: " + error);
+	}
+}
+
+bool DirectAioRandomAccessFile::ReapCompletions(bool & waited) {
+	struct io_event events[COMPLETION_BATCH];
+	// take the ready completions first, so that a completion is timed only if the thread waited for it
+	int count;
+	do {
+		count = aioGetEvents(context, 0, COMPLETION_BATCH, events);
+	} while(count < 0 && errno == EINTR);
+	if(count == 0) {
+		do {
+			count = aioGetEvents(context, 1, COMPLETION_BATCH, events);
+		} while(count < 0 && errno == EINTR);
+		waited = true;
+	}
+	if(count < 0) {
+		return false;
+	}
+	auto now = std::chrono::steady_clock::now();
+	for(int i = 0; i < count; i++) {
+		auto pending = pendingReads.find(events[i].data);
+		if(pending == pendingReads.end()) {
+			continue;
+		}
+		// an error is reported by the file of the read, once all the reads it waits for are reaped
+		auto file = pending->second.file;
+		if(events[i].res < 0) {
+			file->readError = "read fails: " + std::string(strerror((int)-events[i].res));
+		} else if((uint64_t)events[i].res < pending->second.required) {
+			file->readError = "short read of " + std::to_string(events[i].res) + " bytes, expect " +
+			                  std::to_string(pending->second.required) + " bytes";
+		}
+		// a batch that completed before the thread waited for it may have completed long ago,
+		// e.g., a prefetched file is completed only after the current file is decoded
+		auto & batch = pending->second.batch;
+		if(batch != nullptr && --batch->remaining == 0 && waited) {
+			std::chrono::duration<double> elapsed = now - batch->submitted;
+			batch->observer->observe(batch->reads, batch->bytes, elapsed.count());
+		}
+		file->completedReads++;
+		file->inflightReads--;
+		pendingReads.erase(pending);
+	}
+	return true;
+}
@@ -2,18 +2,32 @@
 // Created by yuly on 19.04.23.
 //
 #include "physical/natives/DirectIoLib.h"
+#include "utils/NumaUtil.h"
+#include "utils/HugePageUtil.h"
 
 
 DirectIoLib::DirectIoLib(int fsBlockSize) {
 	this->fsBlockSize = fsBlockSize;
 	this->fsBlockNotMask = ~((long) fsBlockSize - 1);
+	this->numaNode = -1;
+}
+
+void DirectIoLib::setNumaNode(int numaNode) {
+	this->numaNode = numaNode;
 }
 
 std::shared_ptr<ByteBuffer> DirectIoLib::allocateDirectBuffer(long size) {
 	int toAllocate = blockEnd(size) + (size == 1? 0: fsBlockSize);
-	uint8_t * directBufferPointer;
-	posix_memalign((void **)&directBufferPointer, fsBlockSize, toAllocate);
-	auto directBuffer = std::make_shared<ByteBuffer>(directBufferPointer, toAllocate, false);
+	// buffers of at least one huge page are mapped to huge pages if pixel.hugepage.enable is set
+	auto * directBufferPointer = (uint8_t *)HugePageUtil::allocateAligned(fsBlockSize, toAllocate);
+	if(directBufferPointer == nullptr) {
+		throw InvalidArgumentException("DirectIoLib::allocateDirectBuffer: failed to allocate " +
+		                               std::to_string(toAllocate) + " bytes. ");
+	}
+	if(numaNode >= 0) {
+		NumaUtil::bindMemory(directBufferPointer, toAllocate, numaNode);
+	}
+	auto directBuffer = std::make_shared<ByteBuffer>(directBufferPointer, toAllocate, &HugePageUtil::freeBuffer);
 	return directBuffer;
 }
 
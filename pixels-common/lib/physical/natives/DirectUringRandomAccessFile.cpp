@@ -2,124 +2,244 @@
 // Created by liyu on 5/28/23.
 //
 #include "physical/natives/DirectUringRandomAccessFile.h"
+#include "physical/Scheduler.h"
+#include <cstring>
 
 thread_local struct io_uring * DirectUringRandomAccessFile::ring = nullptr;
-thread_local bool DirectUringRandomAccessFile::isRegistered = false;
-thread_local struct iovec * DirectUringRandomAccessFile::iovecs = nullptr;
-thread_local uint32_t DirectUringRandomAccessFile::iovecSize = 0;
+thread_local uint32_t DirectUringRandomAccessFile::registeredCapacity = 0;
+thread_local std::unordered_map<uint64_t, DirectUringRandomAccessFile::PendingRead> DirectUringRandomAccessFile::pendingReads;
+thread_local uint64_t DirectUringRandomAccessFile::nextUserData = 0;
+thread_local bool DirectUringRandomAccessFile::enableFixedFiles = false;
+thread_local std::vector<int> DirectUringRandomAccessFile::freeFileSlots;
+
+#define INITIAL_REGISTERED_BUFFERS 64
+#define REGISTERED_FILE_SLOTS 1024
+#define COMPLETION_BATCH 64
+
+namespace {
+// tears down the ring of a thread when the thread exits
+struct UringThreadGuard {
+    ~UringThreadGuard() {
+        DirectUringRandomAccessFile::Reset();
+    }
+};
+thread_local UringThreadGuard uringThreadGuard;
+}
 
 DirectUringRandomAccessFile::DirectUringRandomAccessFile(const std::string &file) : DirectRandomAccessFile(file) {
 
 }
 
-void DirectUringRandomAccessFile::RegisterBufferFromPool(std::vector<uint32_t> colIds) {
-    std::vector<std::shared_ptr<ByteBuffer>> tmpBuffers;
-    if(!isRegistered) {
-        for(auto buffer : ::BufferPool::buffers) {
-            for(auto colId : colIds) {
-                tmpBuffers.emplace_back(buffer[colId]);
-            }
+void DirectUringRandomAccessFile::RegisterBufferFromPool() {
+    if(ring == nullptr) {
+        // this thread reads with aio or synchronously, the buffers are registered if a ring is created later
+        return;
+    }
+    auto & arena = ::BufferPool::arena;
+    auto & dirtySlots = ::BufferPool::dirtySlots;
+    if(arena.size() > registeredCapacity) {
+        // grow the buffer table, which registers all the buffers again
+        if(registeredCapacity > 0 && io_uring_unregister_buffers(ring) != 0) {
+            throw InvalidArgumentException("DirectUringRandomAccessFile::RegisterBuffer: unregister buffer fails. ");
+        }
+        uint32_t capacity = std::max(registeredCapacity * 2, (uint32_t)INITIAL_REGISTERED_BUFFERS);
+        while(capacity < arena.size()) {
+            capacity *= 2;
         }
-        iovecs = (iovec *)calloc(tmpBuffers.size() ,sizeof(struct iovec));
-        iovecSize = tmpBuffers.size();
-        for(auto i = 0; i < tmpBuffers.size(); i++) {
-            auto buffer = tmpBuffers.at(i);
-            iovecs[i].iov_base = buffer->getPointer();
-            iovecs[i].iov_len = buffer->size();
-            memset(iovecs[i].iov_base, 0, buffer->size());
+        // the entries with a null base are left empty, and filled by io_uring_register_buffers_update_tag later
+        std::vector<struct iovec> iovecs(capacity, iovec{nullptr, 0});
+        std::vector<__u64> tags(capacity, 0);
+        for(uint32_t i = 0; i < arena.size(); i++) {
+            if(arena[i] != nullptr) {
+                iovecs[i].iov_base = arena[i]->getPointer();
+                iovecs[i].iov_len = arena[i]->size();
+            }
         }
-        int ret = io_uring_register_buffers(ring, iovecs, iovecSize);
+        int ret = io_uring_register_buffers_tags(ring, iovecs.data(), tags.data(), capacity);
         if(ret != 0) {
             throw InvalidArgumentException("DirectUringRandomAccessFile::RegisterBuffer: register buffer fails. ");
         }
-        isRegistered = true;
+        registeredCapacity = capacity;
+    } else {
+        for(auto slot : dirtySlots) {
+            // a released buffer empties its entry
+            struct iovec iov{nullptr, 0};
+            if(arena[slot] != nullptr) {
+                iov = iovec{arena[slot]->getPointer(), arena[slot]->size()};
+            }
+            __u64 tag = 0;
+            if(io_uring_register_buffers_update_tag(ring, slot, &iov, &tag, 1) < 0) {
+                throw InvalidArgumentException("DirectUringRandomAccessFile::RegisterBuffer: update buffer fails. ");
+            }
+        }
     }
-}
-
-
-
-void DirectUringRandomAccessFile::RegisterBuffer(std::vector<std::shared_ptr<ByteBuffer>> buffers) {
-	if(!isRegistered) {
-		iovecs = (iovec *)calloc(buffers.size() ,sizeof(struct iovec));
-		iovecSize = buffers.size();
-		for(auto i = 0; i < buffers.size(); i++) {
-			auto buffer = buffers.at(i);
-			iovecs[i].iov_base = buffer->getPointer();
-			iovecs[i].iov_len = buffer->size();
-			memset(iovecs[i].iov_base, 0, buffer->size());
-		}
-		int ret = io_uring_register_buffers(ring, iovecs, iovecSize);
-		if(ret != 0) {
-			throw InvalidArgumentException("DirectUringRandomAccessFile::RegisterBuffer: register buffer fails. ");
-		}
-		isRegistered = true;
-	}
+    dirtySlots.clear();
 }
 
 void DirectUringRandomAccessFile::Initialize() {
 	// initialize io_uring ring
 	if(ring == nullptr) {
 		ring = new io_uring();
-		if(io_uring_queue_init(4096, ring, 0) < 0) {
+		struct io_uring_params params{};
+		if(ConfigFactory::Instance().boolCheckProperty("localfs.iouring.sqpoll")) {
+			params.flags |= IORING_SETUP_SQPOLL;
+			params.sq_thread_idle = std::stoi(ConfigFactory::Instance().getProperty("localfs.iouring.sqpoll.idle"));
+		}
+		int ret = io_uring_queue_init_params(4096, ring, &params);
+		if(ret < 0 && (params.flags & IORING_SETUP_SQPOLL)) {
+			// e.g. the kernel requires privileges for SQPOLL, poll from this thread instead
+			std::cerr << "DirectUringRandomAccessFile: SQPOLL is not available, fall back to a normal ring" << std::endl;
+			params = io_uring_params{};
+			ret = io_uring_queue_init_params(4096, ring, &params);
+		}
+		if(ret < 0) {
+			delete ring;
+			ring = nullptr;
 			throw InvalidArgumentException("DirectRandomAccessFile: initialize io_uring fails.");
 		}
+		freeFileSlots.clear();
+		enableFixedFiles = ConfigFactory::Instance().boolCheckProperty("localfs.iouring.fixed.files");
+		if(enableFixedFiles) {
+			// -1 leaves an entry empty until io_uring_register_files_update fills it
+			std::vector<int> files(REGISTERED_FILE_SLOTS, -1);
+			if(io_uring_register_files(ring, files.data(), REGISTERED_FILE_SLOTS) == 0) {
+				for(int slot = REGISTERED_FILE_SLOTS - 1; slot >= 0; slot--) {
+					freeFileSlots.emplace_back(slot);
+				}
+			} else {
+				enableFixedFiles = false;
+			}
+		}
+		(void)&uringThreadGuard;
 	}
 }
 
 void DirectUringRandomAccessFile::Reset() {
-    // Important! Because sometimes ring is nullptr here.
-    // For example, two threads A and B share the same global state. If A finish all files while B just starts,
-    // B would execute Reset function from InitLocal. If we don't set this 'if' branch, ring would be double freed.
     if(ring != nullptr) {
-        // We don't use this function anymore since it slows down the speed
-        //		if(io_uring_unregister_buffers(ring) != 0) {
-        //			throw InvalidArgumentException("DirectUringRandomAccessFile::UnregisterBuffer: unregister buffer fails. ");
-        //		}
         io_uring_queue_exit(ring);
         delete(ring);
         ring = nullptr;
-        isRegistered = false;
-    }
-    if(iovecs != nullptr) {
-        free(iovecs);
-        iovecs = nullptr;
+        registeredCapacity = 0;
+        pendingReads.clear();
+        freeFileSlots.clear();
     }
 }
 
+void DirectUringRandomAccessFile::releaseFixedFile() {
+	// the table belongs to the ring of the thread that registered fd
+	if(fixedFileIndex >= 0 && fixedFileRing == ring) {
+		int empty = -1;
+		io_uring_register_files_update(ring, fixedFileIndex, &empty, 1);
+		freeFileSlots.emplace_back(fixedFileIndex);
+	}
+	fixedFileIndex = -1;
+	fixedFileRing = nullptr;
+}
+
+void DirectUringRandomAccessFile::close() {
+	releaseFixedFile();
+	DirectRandomAccessFile::close();
+}
+
 DirectUringRandomAccessFile::~DirectUringRandomAccessFile() {
+	// the kernel may still write into the buffers of reads abandoned by an error
+	if(!drain()) {
+		std::cerr << "DirectUringRandomAccessFile: failed to drain the pending reads, "
+		          << "their buffers are not reused" << std::endl;
+		::BufferPool::Abandon();
+		for(auto it = pendingReads.begin(); it != pendingReads.end();) {
+			if(it->second.file == this) {
+				it = pendingReads.erase(it);
+			} else {
+				it++;
+			}
+		}
+	}
+	releaseFixedFile();
+}
 
+bool DirectUringRandomAccessFile::drain() {
+	if(inflightReads > 0 && ring != nullptr && io_uring_sq_ready(ring) > 0) {
+		// the reads prepared before a failed submission are still in the submission queue
+		io_uring_submit(ring);
+	}
+	preparedReads.clear();
+	preparedBytes = 0;
+	bool waited = false;
+	while(inflightReads > 0) {
+		if(ring == nullptr || !ReapCompletions(waited)) {
+			return false;
+		}
+	}
+	// the reads were not waited for by readAsyncComplete, so neither are their errors reported
+	completedReads = 0;
+	readError.clear();
+	return true;
 }
 
 std::shared_ptr<ByteBuffer> DirectUringRandomAccessFile::readAsync(int length, std::shared_ptr<ByteBuffer> buffer, int index) {
+	struct io_uring_sqe * sqe = io_uring_get_sqe(ring);
+	if(sqe == nullptr) {
+		throw InvalidArgumentException("DirectUringRandomAccessFile::readAsync: the submission queue is full.");
+	}
+	if(enableFixedFiles && fixedFileIndex < 0 && !freeFileSlots.empty()) {
+		int slot = freeFileSlots.back();
+		if(io_uring_register_files_update(ring, slot, &fd, 1) == 1) {
+			freeFileSlots.pop_back();
+			fixedFileIndex = slot;
+			fixedFileRing = ring;
+		}
+	}
+	int target = fixedFileIndex >= 0 ? fixedFileIndex : fd;
+	std::shared_ptr<ByteBuffer> result;
+	uint32_t required;
+	uint64_t bytes;
 	if(enableDirect) {
-		struct io_uring_sqe * sqe = io_uring_get_sqe(ring);
 //		if(length > iovecs[index].iov_len) {
 //			throw InvalidArgumentException("DirectUringRandomAccessFile::readAsync: the length is larger than buffer length.");
 //		}
 		// the file will be read from blockStart(fileOffset), and the first fileDelta bytes should be ignored.
 		uint64_t fileOffsetAligned = directIoLib->blockStart(offset);
 		uint64_t toRead = directIoLib->blockEnd(offset + length) - directIoLib->blockStart(offset);
-        io_uring_prep_read_fixed(sqe, fd, buffer->getPointer(), toRead,
+        io_uring_prep_read_fixed(sqe, target, buffer->getPointer(), toRead,
 		                         fileOffsetAligned, index);
-		auto bb = std::make_shared<ByteBuffer>(*buffer,
-		                                       offset - fileOffsetAligned, length);
-		seek(offset + length);
-		return bb;
+		result = std::make_shared<ByteBuffer>(*buffer,
+		                                      offset - fileOffsetAligned, length);
+		required = offset + length - fileOffsetAligned;
+		bytes = toRead;
 	} else {
-		struct io_uring_sqe * sqe = io_uring_get_sqe(ring);
 //		if(length > iovecs[index].iov_len) {
 //			throw InvalidArgumentException("DirectUringRandomAccessFile::readAsync: the length is larger than buffer length.");
 //		}
-		io_uring_prep_read_fixed(sqe, fd, buffer->getPointer(), length, offset, index);
-		seek(offset + length);
-		auto result = std::make_shared<ByteBuffer>(*buffer, 0, length);
-		return result;
+		io_uring_prep_read_fixed(sqe, target, buffer->getPointer(), length, offset, index);
+		result = std::make_shared<ByteBuffer>(*buffer, 0, length);
+		required = length;
+		bytes = length;
 	}
-
+	if(fixedFileIndex >= 0) {
+		io_uring_sqe_set_flags(sqe, IOSQE_FIXED_FILE);
+	}
+	sqe->user_data = nextUserData;
+	preparedReads.emplace_back(nextUserData);
+	preparedBytes += bytes;
+	pendingReads[nextUserData++] = PendingRead{this, required, nullptr};
+	inflightReads++;
+	seek(offset + length);
+	return result;
 }
 
 
-void DirectUringRandomAccessFile::readAsyncSubmit(int size) {
+void DirectUringRandomAccessFile::readAsyncSubmit(int size, Scheduler * observer) {
+	if(observer != nullptr && !preparedReads.empty()) {
+		auto batch = std::make_shared<AsyncBatch>(AsyncBatch{observer, std::chrono::steady_clock::now(),
+		                                                     (int)preparedReads.size(), preparedBytes,
+		                                                     (int)preparedReads.size()});
+		for(auto userData : preparedReads) {
+			pendingReads.at(userData).batch = batch;
+		}
+	}
+	preparedReads.clear();
+	preparedBytes = 0;
 	int ret = io_uring_submit(ring);
 	if(ret != size) {
 		throw InvalidArgumentException("DirectUringRandomAccessFile::readAsyncSubmit: submit fails");
@@ -127,15 +247,64 @@ void DirectUringRandomAccessFile::readAsyncSubmit(int size) {
 }
 
 void DirectUringRandomAccessFile::readAsyncComplete(int size) {
-	// Important! We cannot write the code as io_uring_wait_cqe_nr(ring, &cqe, iovecSize).
-	// The reason is unclear, but some random bugs would happen. It takes me nearly a week to find this bug
-	struct io_uring_cqe *cqe;
-	for(int i = 0; i < size; i++) {
-		if(io_uring_wait_cqe_nr(ring, &cqe, 1) != 0) {
+	// completions of other files on this ring are credited to their own files
+	bool waited = false;
+	while(completedReads < size) {
+		if(!ReapCompletions(waited)) {
 			throw InvalidArgumentException("DirectUringRandomAccessFile::readAsyncComplete: wait cqe fails");
 		}
-		io_uring_cqe_seen(ring, cqe);
+	}
+	completedReads -= size;
+	if(!readError.empty()) {
+		std::string error = std::move(readError);
+		readError.clear();
+		throw InvalidArgumentException("DirectUringRandomAccessFile::readAsyncComplete: " + error);
 	}
 }
 
-
+bool DirectUringRandomAccessFile::ReapCompletions(bool & waited) {
+	// Important! We cannot write the code as io_uring_wait_cqe_nr(ring, &cqe, iovecSize).
+	// The reason is unclear, but some random bugs would happen. So wait for one completion
+	// and then take whatever else is ready without another syscall.
+	struct io_uring_cqe * cqes[COMPLETION_BATCH];
+	unsigned count = io_uring_peek_batch_cqe(ring, cqes, COMPLETION_BATCH);
+	if(count == 0) {
+		struct io_uring_cqe * cqe;
+		int ret;
+		do {
+			ret = io_uring_wait_cqe_nr(ring, &cqe, 1);
+		} while(ret == -EINTR);
+		if(ret != 0) {
+			return false;
+		}
+		waited = true;
+		count = io_uring_peek_batch_cqe(ring, cqes, COMPLETION_BATCH);
+	}
+	auto now = std::chrono::steady_clock::now();
+	for(unsigned i = 0; i < count; i++) {
+		auto pending = pendingReads.find(cqes[i]->user_data);
+		if(pending == pendingReads.end()) {
+			continue;
+		}
+		// an error is reported by the file of the read, once all the reads it waits for are reaped
+		auto file = pending->second.file;
+		if(cqes[i]->res < 0) {
+			file->readError = "read fails: " + std::string(strerror(-cqes[i]->res));
+		} else if((uint32_t)cqes[i]->res < pending->second.required) {
+			file->readError = "short read of " + std::to_string(cqes[i]->res) + " bytes, expect " +
+			                  std::to_string(pending->second.required) + " bytes";
+		}
+		// a batch that completed before the thread waited for it may have completed long ago,
+		// e.g., a prefetched file is completed only after the current file is decoded
+		auto & batch = pending->second.batch;
+		if(batch != nullptr && --batch->remaining == 0 && waited) {
+			std::chrono::duration<double> elapsed = now - batch->submitted;
+			batch->observer->observe(batch->reads, batch->bytes, elapsed.count());
+		}
+		file->completedReads++;
+		file->inflightReads--;
+		pendingReads.erase(pending);
+	}
+	io_uring_cq_advance(ring, count);
+	return true;
+}
@@ -0,0 +1,91 @@
+//
+// Created by pixels on 10/18/26.
+//
+
+#include "physical/natives/MmapRandomAccessFile.h"
+#include "exception/InvalidArgumentException.h"
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+MmapRandomAccessFile::MmapRandomAccessFile(const std::string& file) {
+    int fd = open(file.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("MmapRandomAccessFile: File not found or fd exceeds the limitation. ");
+    }
+    struct stat fileStat{};
+    if (fstat(fd, &fileStat) != 0) {
+        ::close(fd);
+        throw std::runtime_error("MmapRandomAccessFile: failed to stat " + file);
+    }
+    len = fileStat.st_size;
+    mapping = nullptr;
+    if (len > 0) {
+        void * address = mmap(nullptr, len, PROT_READ, MAP_SHARED, fd, 0);
+        if (address == MAP_FAILED) {
+            ::close(fd);
+            throw std::runtime_error("MmapRandomAccessFile: failed to map " + file);
+        }
+        mapping = (uint8_t *)address;
+    }
+    // the mapping keeps the file open
+    ::close(fd);
+    offset = 0;
+}
+
+void MmapRandomAccessFile::keepMapping(uint8_t * address, uint32_t size) {
+}
+
+void MmapRandomAccessFile::close() {
+    if (mapping != nullptr) {
+        munmap(mapping, len);
+        mapping = nullptr;
+    }
+    offset = 0;
+    len = 0;
+}
+
+MmapRandomAccessFile::~MmapRandomAccessFile() {
+    close();
+}
+
+std::shared_ptr<ByteBuffer> MmapRandomAccessFile::readFully(int len) {
+    if (mapping == nullptr || offset < 0 || offset + len > this->len) {
+        throw InvalidArgumentException("MmapRandomAccessFile::readFully: read beyond the end of file. ");
+    }
+    // start reading the pages of a chunk into the page cache, which is not worth a syscall
+    // for the small reads of the file tail. madvise works on whole pages
+    static const long pageSize = sysconf(_SC_PAGESIZE);
+    if (len >= pageSize) {
+        long adviseStart = offset & ~(pageSize - 1);
+        madvise(mapping + adviseStart, offset + len - adviseStart, MADV_WILLNEED);
+    }
+    auto buffer = std::make_shared<ByteBuffer>(mapping + offset, (uint32_t)len, &MmapRandomAccessFile::keepMapping);
+    seek(offset + len);
+    return buffer;
+}
+
+std::shared_ptr<ByteBuffer> MmapRandomAccessFile::readFully(int len, std::shared_ptr<ByteBuffer> bb) {
+    return readFully(len);
+}
+
+long MmapRandomAccessFile::length() {
+    return len;
+}
+
+void MmapRandomAccessFile::seek(long off) {
+    offset = off;
+}
+
+long MmapRandomAccessFile::readLong() {
+    return readFully(sizeof(long))->getLong();
+}
+
+char MmapRandomAccessFile::readChar() {
+    return readFully(sizeof(char))->getChar();
+}
+
+int MmapRandomAccessFile::readInt() {
+    return readFully(sizeof(int))->getInt();
+}
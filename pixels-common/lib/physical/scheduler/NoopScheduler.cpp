@@ -26,7 +26,7 @@ std::vector<std::shared_ptr<ByteBuffer>> NoopScheduler::executeBatch(std::shared
 	auto requests = batch.getRequests();
 	std::vector<std::shared_ptr<ByteBuffer>> results;
 	results.resize(batch.getSize());
-	if(ConfigFactory::Instance().boolCheckProperty("localfs.enable.async.io") && reuseBuffers.size() > 0) {
+	if(LocalFS::isAsyncEnabled() && reuseBuffers.size() > 0) {
 		// async read
 		auto localReader = std::static_pointer_cast<PhysicalLocalReader>(reader);
 		for(int i = 0; i < batch.getSize(); i++) {
@@ -0,0 +1,243 @@
+//
+// Created by pixels on 10/18/26.
+//
+
+#include "physical/scheduler/RateLimitedScheduler.h"
+#include "physical/scheduler/NoopScheduler.h"
+#include "exception/InvalidArgumentException.h"
+#include "utils/ConfigFactory.h"
+#include <algorithm>
+#include <cctype>
+#include <sys/stat.h>
+#include <thread>
+
+// the buckets hold at most this much time of tokens, which bounds the burst after idling
+#define BURST_SECONDS 0.1
+// the paths whose devices each thread remembers
+#define DEVICE_CACHE_SIZE 1024
+
+Scheduler * RateLimitedScheduler::instance = nullptr;
+thread_local std::unordered_map<std::string, std::shared_ptr<RateLimitedScheduler::DeviceQueue>> RateLimitedScheduler::deviceCache;
+
+Scheduler * RateLimitedScheduler::Instance() {
+    if(instance == nullptr) {
+        instance = new RateLimitedScheduler();
+    }
+    return instance;
+}
+
+RateLimitedScheduler::RateLimitedScheduler() {
+    deviceBandwidth = std::stod(ConfigFactory::Instance().getProperty("read.ratelimit.device.bandwidth"));
+    deviceIops = std::stod(ConfigFactory::Instance().getProperty("read.ratelimit.device.iops"));
+    queryBandwidth = std::stod(ConfigFactory::Instance().getProperty("read.ratelimit.query.bandwidth"));
+    queryIops = std::stod(ConfigFactory::Instance().getProperty("read.ratelimit.query.iops"));
+    metrics = Metrics{};
+}
+
+RateLimitedScheduler::Priority RateLimitedScheduler::parsePriority(const std::string & priority) {
+    std::string name = priority;
+    std::transform(name.begin(), name.end(), name.begin(),
+                   [](unsigned char c){ return std::tolower(c); });
+    if(name == "interactive") {
+        return INTERACTIVE;
+    } else if(name == "normal") {
+        return NORMAL;
+    } else if(name == "background") {
+        return BACKGROUND;
+    }
+    throw InvalidArgumentException("RateLimitedScheduler: unknown priority " + priority +
+                                   ", it should be interactive, normal or background. ");
+}
+
+std::string RateLimitedScheduler::priorityName(Priority priority) {
+    switch(priority) {
+        case INTERACTIVE:
+            return "interactive";
+        case NORMAL:
+            return "normal";
+        default:
+            return "background";
+    }
+}
+
+void RateLimitedScheduler::TokenBucket::init(double bytesPerSecond, double iops) {
+    this->bytesPerSecond = bytesPerSecond;
+    this->iops = iops;
+    byteTokens = bytesPerSecond * BURST_SECONDS;
+    ioTokens = iops * BURST_SECONDS;
+    last = std::chrono::steady_clock::now();
+}
+
+void RateLimitedScheduler::TokenBucket::refill(std::chrono::steady_clock::time_point now) {
+    std::chrono::duration<double> elapsed = now - last;
+    last = now;
+    if(bytesPerSecond > 0) {
+        byteTokens = std::min(byteTokens + elapsed.count() * bytesPerSecond, bytesPerSecond * BURST_SECONDS);
+    }
+    if(iops > 0) {
+        ioTokens = std::min(ioTokens + elapsed.count() * iops, iops * BURST_SECONDS);
+    }
+}
+
+double RateLimitedScheduler::TokenBucket::waitSeconds() const {
+    double seconds = 0;
+    if(bytesPerSecond > 0 && byteTokens < 0) {
+        seconds = std::max(seconds, -byteTokens / bytesPerSecond);
+    }
+    if(iops > 0 && ioTokens < 0) {
+        seconds = std::max(seconds, -ioTokens / iops);
+    }
+    return seconds;
+}
+
+void RateLimitedScheduler::TokenBucket::take(uint64_t bytes, int requests) {
+    if(bytesPerSecond > 0) {
+        byteTokens -= (double)bytes;
+    }
+    if(iops > 0) {
+        ioTokens -= requests;
+    }
+}
+
+void RateLimitedScheduler::registerQuery(long queryId, Priority priority) {
+    std::lock_guard<std::mutex> guard(queriesLock);
+    auto & query = queries[queryId];
+    if(query.scans == 0) {
+        query.bucket.init(queryBandwidth, queryIops);
+    }
+    query.priority = priority;
+    query.scans++;
+}
+
+void RateLimitedScheduler::unregisterQuery(long queryId) {
+    std::lock_guard<std::mutex> guard(queriesLock);
+    auto query = queries.find(queryId);
+    if(query != queries.end() && --query->second.scans <= 0) {
+        queries.erase(query);
+    }
+}
+
+RateLimitedScheduler::Priority RateLimitedScheduler::getPriority(long queryId) {
+    std::lock_guard<std::mutex> guard(queriesLock);
+    auto query = queries.find(queryId);
+    return query == queries.end() ? NORMAL : query->second.priority;
+}
+
+RateLimitedScheduler::Metrics RateLimitedScheduler::getMetrics() {
+    std::lock_guard<std::mutex> guard(metricsLock);
+    return metrics;
+}
+
+std::shared_ptr<RateLimitedScheduler::DeviceQueue> RateLimitedScheduler::getDeviceQueue(const std::string & path) {
+    auto cached = deviceCache.find(path);
+    if(cached != deviceCache.end()) {
+        return cached->second;
+    }
+    if(deviceCache.size() >= DEVICE_CACHE_SIZE) {
+        deviceCache.clear();
+    }
+    struct stat fileStat{};
+    uint64_t device = stat(path.c_str(), &fileStat) == 0 ? fileStat.st_dev : 0;
+    std::lock_guard<std::mutex> guard(devicesLock);
+    auto & queue = devices[device];
+    if(queue == nullptr) {
+        queue = std::make_shared<DeviceQueue>();
+        queue->bucket.init(deviceBandwidth, deviceIops);
+    }
+    deviceCache[path] = queue;
+    return queue;
+}
+
+void RateLimitedScheduler::acquireQueryTokens(long queryId, uint64_t bytes, int requests) {
+    if(queryBandwidth <= 0 && queryIops <= 0) {
+        return;
+    }
+    while(true) {
+        double seconds;
+        {
+            std::lock_guard<std::mutex> guard(queriesLock);
+            auto query = queries.find(queryId);
+            if(query == queries.end()) {
+                // unregistered queries are only limited by their devices
+                return;
+            }
+            auto & bucket = query->second.bucket;
+            bucket.refill(std::chrono::steady_clock::now());
+            seconds = bucket.waitSeconds();
+            if(seconds <= 0) {
+                bucket.take(bytes, requests);
+                return;
+            }
+        }
+        std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+    }
+}
+
+std::vector<std::shared_ptr<ByteBuffer>> RateLimitedScheduler::executeBatch(std::shared_ptr<PhysicalReader> reader,
+                                                                            RequestBatch batch, long queryId) {
+    return executeBatch(reader, batch, {}, queryId);
+}
+
+std::vector<std::shared_ptr<ByteBuffer>> RateLimitedScheduler::executeBatch(std::shared_ptr<PhysicalReader> reader, RequestBatch batch,
+                                                                            std::vector<std::shared_ptr<ByteBuffer>> reuseBuffers, long queryId) {
+    if(batch.getSize() <= 0) {
+        return std::vector<std::shared_ptr<ByteBuffer>>{};
+    }
+    uint64_t bytes = 0;
+    for(auto & request : batch.getRequests()) {
+        bytes += request.length;
+    }
+    Priority priority = getPriority(queryId);
+    auto waitStart = std::chrono::steady_clock::now();
+    acquireQueryTokens(queryId, bytes, batch.getSize());
+
+    auto queue = getDeviceQueue(reader->getPath());
+    {
+        std::unique_lock<std::mutex> lock(queue->lock);
+        queue->waiting[priority]++;
+        {
+            std::lock_guard<std::mutex> guard(metricsLock);
+            metrics.queueDepth[priority]++;
+        }
+        while(true) {
+            bool preempted = false;
+            for(int higher = 0; higher < priority; higher++) {
+                preempted |= queue->waiting[higher] > 0;
+            }
+            queue->bucket.refill(std::chrono::steady_clock::now());
+            double seconds = queue->bucket.waitSeconds();
+            if(!preempted && seconds <= 0) {
+                break;
+            }
+            if(preempted) {
+                queue->available.wait(lock);
+            } else {
+                queue->available.wait_for(lock, std::chrono::duration<double>(seconds));
+            }
+        }
+        queue->bucket.take(bytes, batch.getSize());
+        queue->waiting[priority]--;
+    }
+    // the waiters of lower priority may go now, or recompute their wait
+    queue->available.notify_all();
+    std::chrono::duration<double> waited = std::chrono::steady_clock::now() - waitStart;
+    {
+        std::lock_guard<std::mutex> guard(metricsLock);
+        metrics.queueDepth[priority]--;
+        metrics.inFlight[priority]++;
+        metrics.admittedBatches[priority]++;
+        metrics.admittedBytes[priority] += bytes;
+        metrics.throttledSeconds[priority] += waited.count();
+    }
+    std::vector<std::shared_ptr<ByteBuffer>> results;
+    try {
+        results = NoopScheduler::Instance()->executeBatch(reader, batch, reuseBuffers, queryId);
+    } catch (...) {
+        std::lock_guard<std::mutex> guard(metricsLock);
+        metrics.inFlight[priority]--;
+        throw;
+    }
+    std::lock_guard<std::mutex> guard(metricsLock);
+    metrics.inFlight[priority]--;
+    return results;
+}
@@ -5,6 +5,10 @@
 #include "physical/scheduler/SortMergeScheduler.h"
 #include "utils/ConfigFactory.h"
 #include "exception/InvalidArgumentException.h"
+#include "physical/BufferPool.h"
+#include "physical/io/PhysicalLocalReader.h"
+#include <chrono>
+#include <numeric>
 
 Scheduler * SortMergeScheduler::instance = nullptr;
 
@@ -24,35 +28,108 @@ std::vector<std::shared_ptr<ByteBuffer>> SortMergeScheduler::executeBatch(std::s
 
 std::vector<std::shared_ptr<ByteBuffer>> SortMergeScheduler::executeBatch(std::shared_ptr<PhysicalReader> reader, RequestBatch batch,
                                                       std::vector<std::shared_ptr<ByteBuffer>> reuseBuffers, long queryId) {
-    if(batch.getSize() < 0) {
+    if(batch.getSize() <= 0) {
         return std::vector<std::shared_ptr<ByteBuffer>>{};
     }
-    auto mergeRequests = sortMerge(batch, queryId);
-    std::vector<std::shared_ptr<ByteBuffer>> bbs;
+    auto requests = batch.getRequests();
+    std::vector<int> order;
+    auto mergeRequests = sortMerge(batch, queryId, order);
+    // the results are in the order of the requests in the batch
+    std::vector<std::shared_ptr<ByteBuffer>> bbs(batch.getSize());
+    bool async = LocalFS::isAsyncEnabled() && !reuseBuffers.empty();
+    auto startTime = std::chrono::steady_clock::now();
+    uint64_t bytes = 0;
+    uint32_t mergedBufferNum = 0;
+    int next = 0;
     for(auto merged : mergeRequests) {
+        int first = order.at(next);
         reader->seek(merged->getStart());
-        auto buffer = reader->readFully(merged->getLength());
-        auto separateBuffers = merged->complete(buffer);
-        bbs.insert(bbs.end(), separateBuffers.begin(), separateBuffers.end());
+        std::shared_ptr<ByteBuffer> buffer;
+        if(async) {
+            auto localReader = std::static_pointer_cast<PhysicalLocalReader>(reader);
+            // a direct read may cover one more block at each end
+            uint64_t required = merged->getLength() + 2 * fsBlockSize;
+            std::shared_ptr<ByteBuffer> target = reuseBuffers.at(first);
+            int64_t bufferId = requests.at(first).bufferId;
+            if(merged->getSize() > 1 && target->size() < required) {
+                target = ::BufferPool::GetMergedBuffer(mergedBufferNum++, required, bufferId);
+                ::DirectUringRandomAccessFile::RegisterBufferFromPool();
+            }
+            buffer = localReader->readAsync(merged->getLength(), target, (int)bufferId);
+        } else if(merged->getSize() == 1 && !reuseBuffers.empty()) {
+            buffer = reader->readFully(merged->getLength(), reuseBuffers.at(first));
+        } else {
+            buffer = reader->readFully(merged->getLength());
+        }
+        for(auto & bb : merged->complete(buffer)) {
+            bbs.at(order.at(next++)) = bb;
+        }
+        bytes += merged->getLength();
+    }
+    if(async) {
+        // the merged reads are observed when they are reaped, if the scan has to wait for them
+        std::static_pointer_cast<PhysicalLocalReader>(reader)->readAsyncSubmit(mergeRequests.size(), this);
+    } else {
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - startTime;
+        observe((int)mergeRequests.size(), bytes, elapsed.count());
     }
     return bbs;
 }
 
 SortMergeScheduler::SortMergeScheduler() {
+    mergeGap = std::stol(ConfigFactory::Instance().getProperty("read.request.merge.gap"));
+    adaptive = ConfigFactory::Instance().boolCheckProperty("read.request.merge.gap.adaptive");
+    maxMergeGap = std::stol(ConfigFactory::Instance().getProperty("read.request.merge.gap.max"));
+    fsBlockSize = std::stoi(ConfigFactory::Instance().getProperty("localfs.block.size"));
+}
 
+long SortMergeScheduler::getMergeGap() {
+    return mergeGap;
+}
+
+void SortMergeScheduler::observe(int requests, uint64_t bytes, double seconds) {
+    if(!adaptive || requests <= 0 || seconds <= 0) {
+        return;
+    }
+    std::lock_guard<std::mutex> guard(fitLock);
+    // older observations fade out, so the fit follows the current load of the device
+    const double decay = 0.95;
+    double r = requests;
+    double b = (double)bytes;
+    sumRR = sumRR * decay + r * r;
+    sumRB = sumRB * decay + r * b;
+    sumBB = sumBB * decay + b * b;
+    sumRT = sumRT * decay + r * seconds;
+    sumBT = sumBT * decay + b * seconds;
+    double det = sumRR * sumBB - sumRB * sumRB;
+    if(det <= 1e-9 * sumRR * sumBB) {
+        // all batches have the same bytes per request so far, the two costs cannot be told apart
+        return;
+    }
+    double requestCost = (sumRT * sumBB - sumBT * sumRB) / det;
+    double byteCost = (sumBT * sumRR - sumRT * sumRB) / det;
+    if(requestCost <= 0 || byteCost <= 0) {
+        return;
+    }
+    // reading the gap is cheaper than issuing another request while gap * byteCost < requestCost
+    mergeGap = std::min((long)(requestCost / byteCost), maxMergeGap);
 }
 
-std::vector<std::shared_ptr<MergedRequest>> SortMergeScheduler::sortMerge(RequestBatch batch, long queryId) {
+std::vector<std::shared_ptr<MergedRequest>> SortMergeScheduler::sortMerge(RequestBatch batch, long queryId,
+                                                                          std::vector<int> & order) {
     auto requests = batch.getRequests();
-    std::sort(requests.begin(), requests.end(), [](const Request& lhs, const Request& rhs) {
-        return lhs.start < rhs.start;
+    order.resize(requests.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&requests](int lhs, int rhs) {
+        return requests.at(lhs).start < requests.at(rhs).start;
     });
 
+    long maxGap = mergeGap;
     std::vector<std::shared_ptr<MergedRequest>> mergedRequests;
-    auto mr1 = std::make_shared<MergedRequest>(requests.at(0));
+    auto mr1 = std::make_shared<MergedRequest>(requests.at(order.at(0)), maxGap);
     auto mr2 = mr1;
     for(int i = 1; i < batch.getSize(); i++) {
-        mr2 = mr1->merge(requests.at(i));
+        mr2 = mr1->merge(requests.at(order.at(i)));
         if(mr1 == mr2) {
             continue;
         }
@@ -5,11 +5,16 @@
 #include "physical/storage/LocalFS.h"
 #include "physical/natives/DirectRandomAccessFile.h"
 #include "physical/natives/DirectUringRandomAccessFile.h"
+#include "physical/natives/DirectAioRandomAccessFile.h"
+#include "physical/natives/MmapRandomAccessFile.h"
 #include "physical/FilePath.h"
 #include <filesystem>
 namespace fs = std::filesystem;
 
 std::string LocalFS::SchemePrefix = "file://";
+std::atomic<bool> LocalFS::uringUnavailable{false};
+thread_local bool LocalFS::threadAsyncIoInitialized = false;
+thread_local LocalFS::AsyncLib LocalFS::threadAsyncLib = LocalFS::IOURING;
 
 LocalFS::LocalFS() {
 
@@ -31,12 +36,76 @@ std::string LocalFS::ensureSchemePrefix(const std::string &path) const {
 }
 
 std::shared_ptr<PixelsRandomAccessFile> LocalFS::openRaf(const std::string& path) {
-    if(true) {
-        // TODO: change this class to mmap class in the future.
+    if(getIoMode() == MMAP) {
+        return std::make_shared<MmapRandomAccessFile>(path);
+    }
+    // another thread may fall back to aio after this thread has set up its ring
+    AsyncLib asyncLib = threadAsyncIoInitialized ? threadAsyncLib : getAsyncLib();
+    if(asyncLib == AIO) {
+        return std::make_shared<DirectAioRandomAccessFile>(path);
+    } else {
         return std::make_shared<DirectUringRandomAccessFile>(path);
+    }
+}
+
+LocalFS::AsyncLib LocalFS::getAsyncLib() {
+    std::string asyncLib = ConfigFactory::Instance().getProperty("localfs.async.lib");
+    if(asyncLib == "iouring") {
+        return uringUnavailable ? AIO : IOURING;
+    } else if(asyncLib == "aio") {
+        return AIO;
+    } else {
+        throw InvalidArgumentException("LocalFS::getAsyncLib: the async read method is unknown. ");
+    }
+}
+
+LocalFS::IoMode LocalFS::getIoMode() {
+    std::string ioMode = ConfigFactory::Instance().getProperty("localfs.io.mode");
+    if(ioMode == "direct") {
+        return DIRECT;
+    } else if(ioMode == "mmap") {
+        return MMAP;
+    } else {
+        throw InvalidArgumentException("LocalFS::getIoMode: the io mode is unknown. ");
+    }
+}
+
+bool LocalFS::isAsyncEnabled() {
+    return getIoMode() == DIRECT && ConfigFactory::Instance().boolCheckProperty("localfs.enable.async.io");
+}
+
+bool LocalFS::isDirectWriteEnabled() {
+    std::string writeMode = ConfigFactory::Instance().getProperty("localfs.write.mode");
+    if(writeMode == "direct") {
+        return true;
+    } else if(writeMode == "buffered") {
+        return false;
     } else {
-        return std::make_shared<DirectRandomAccessFile>(path);
+        throw InvalidArgumentException("LocalFS::isDirectWriteEnabled: the write mode is unknown. ");
+    }
+}
+
+void LocalFS::initializeAsyncIo() {
+    if(getIoMode() == MMAP) {
+        // the reads are views into the mapping, which need neither a ring nor a context
+        return;
+    }
+    if(getAsyncLib() == IOURING) {
+        try {
+            DirectUringRandomAccessFile::Initialize();
+            threadAsyncLib = IOURING;
+            threadAsyncIoInitialized = true;
+            return;
+        } catch (InvalidArgumentException & e) {
+            // e.g. io_uring is disabled by seccomp or the io_uring_disabled sysctl
+            if(!uringUnavailable.exchange(true)) {
+                std::cerr << "LocalFS: io_uring is not available, fall back to aio" << std::endl;
+            }
+        }
     }
+    DirectAioRandomAccessFile::Initialize();
+    threadAsyncLib = AIO;
+    threadAsyncIoInitialized = true;
 }
 
 std::vector<std::string> LocalFS::listPaths(const std::string &path) {
@@ -24,8 +24,16 @@
 
 #include "physical/storage/LocalFSProvider.h"
 #include "physical/storage/PhysicalLocalWriter.h"
+#include "physical/storage/PhysicalDirectWriter.h"
+#include "physical/storage/LocalFS.h"
+#include <filesystem>
 
 std::shared_ptr <PhysicalWriter>
 LocalFSProvider::createWriter(const std::string &path, std::shared_ptr <PhysicalWriterOption> option) {
+    // O_DIRECT files are written from the start, appending to an existing file is left to the buffered writer.
+    // A file that does not exist yet, such as a new file of the loader, is written from the start either way
+    if ((option->isOverwrite() || !std::filesystem::exists(path)) && LocalFS::isDirectWriteEnabled()) {
+        return std::static_pointer_cast<PhysicalWriter>(std::make_shared<PhysicalDirectWriter>(path));
+    }
     return std::static_pointer_cast<PhysicalWriter>(std::make_shared<PhysicalLocalWriter>(path, option->isOverwrite()));
 }
\ No newline at end of file
@@ -0,0 +1,198 @@
+//
+// Created by pixels on 10/18/26.
+//
+
+#include "physical/storage/PhysicalDirectWriter.h"
+#include "exception/InvalidArgumentException.h"
+#include "utils/ConfigFactory.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+PhysicalDirectWriter::PhysicalDirectWriter(const std::string &path) {
+    this->path = path;
+    this->position = 0;
+    this->bufferStart = 0;
+    this->current = 0;
+    this->inFlight = 0;
+    this->ring = nullptr;
+    this->blockSize = std::stoi(ConfigFactory::Instance().getProperty("localfs.block.size"));
+    // a staging buffer holds whole blocks
+    int configured = std::stoi(ConfigFactory::Instance().getProperty("localfs.write.buffer.size"));
+    this->bufferSize = std::max(blockSize, configured / blockSize * blockSize);
+    int queueDepth = std::max(1, std::stoi(ConfigFactory::Instance().getProperty("localfs.write.queue.depth")));
+
+    this->fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_DIRECT, 0644);
+    if (this->fd < 0) {
+        throw std::runtime_error("Failed to open file with O_DIRECT: " + path + ", " + std::strerror(errno));
+    }
+    DirectIoLib directIoLib(blockSize);
+    buffers.resize(queueDepth);
+    for (auto &staging : buffers) {
+        staging.buffer = directIoLib.allocateDirectBuffer(bufferSize);
+    }
+    if (queueDepth > 1) {
+        ring = new io_uring();
+        if (io_uring_queue_init(queueDepth, ring, 0) != 0) {
+            // e.g. io_uring is disabled by seccomp, write the buffers by pwrite instead
+            delete ring;
+            ring = nullptr;
+        }
+    }
+}
+
+PhysicalDirectWriter::~PhysicalDirectWriter() {
+    try {
+        close();
+    } catch (const std::exception &e) {
+        std::cerr << e.what() << std::endl;
+    }
+}
+
+std::int64_t PhysicalDirectWriter::prepare(int length) {
+    return position;
+}
+
+std::int64_t PhysicalDirectWriter::append(const uint8_t *buffer, int offset, int length) {
+    std::int64_t start = position;
+    const uint8_t *src = buffer + offset;
+    while (length > 0) {
+        StagingBuffer &staging = buffers[current];
+        int filled = static_cast<int>(position - bufferStart);
+        int toCopy = std::min(length, bufferSize - filled);
+        memcpy(staging.buffer->getPointer() + filled, src, toCopy);
+        src += toCopy;
+        length -= toCopy;
+        position += toCopy;
+        if (position - bufferStart == bufferSize) {
+            submitCurrent();
+        }
+    }
+    return start;
+}
+
+std::int64_t PhysicalDirectWriter::append(std::shared_ptr<ByteBuffer> byteBuffer) {
+    byteBuffer->filp();
+    int length = byteBuffer->bytesRemaining();
+    return append(byteBuffer->getPointer(), byteBuffer->getBufferOffset(), length);
+}
+
+std::int64_t PhysicalDirectWriter::append(const std::vector<struct iovec> &buffers) {
+    std::int64_t start = position;
+    for (const auto &buffer : buffers) {
+        append(static_cast<const uint8_t *>(buffer.iov_base), 0, buffer.iov_len);
+    }
+    return start;
+}
+
+void PhysicalDirectWriter::submitCurrent() {
+    StagingBuffer &staging = buffers[current];
+    staging.fileOffset = bufferStart;
+    staging.length = bufferSize;
+    if (ring == nullptr) {
+        writeFully(staging.buffer->getPointer(), staging.length, staging.fileOffset);
+    } else {
+        struct io_uring_sqe *sqe = io_uring_get_sqe(ring);
+        if (sqe == nullptr) {
+            throw InvalidArgumentException("PhysicalDirectWriter::submitCurrent: io_uring is full");
+        }
+        io_uring_prep_write(sqe, fd, staging.buffer->getPointer(), staging.length, staging.fileOffset);
+        io_uring_sqe_set_data64(sqe, current);
+        if (io_uring_submit(ring) < 0) {
+            throw InvalidArgumentException("PhysicalDirectWriter::submitCurrent: submit fails");
+        }
+        staging.inFlight = true;
+        inFlight++;
+    }
+    bufferStart += bufferSize;
+    current = (current + 1) % buffers.size();
+    waitFor(buffers[current]);
+}
+
+void PhysicalDirectWriter::waitFor(StagingBuffer &staging) {
+    while (staging.inFlight) {
+        struct io_uring_cqe *cqe = nullptr;
+        int ret = io_uring_wait_cqe(ring, &cqe);
+        if (ret == -EINTR) {
+            continue;
+        }
+        if (ret < 0) {
+            throw InvalidArgumentException("PhysicalDirectWriter::waitFor: wait fails");
+        }
+        reap(cqe);
+    }
+}
+
+void PhysicalDirectWriter::reap(struct io_uring_cqe *cqe) {
+    StagingBuffer &staging = buffers[io_uring_cqe_get_data64(cqe)];
+    int res = cqe->res;
+    io_uring_cqe_seen(ring, cqe);
+    staging.inFlight = false;
+    inFlight--;
+    if (res < 0) {
+        throw std::runtime_error("Failed to write file: " + path + ", " + std::strerror(-res));
+    }
+    if (res < staging.length) {
+        // a short write ends on a block boundary, write the rest synchronously
+        writeFully(staging.buffer->getPointer() + res, staging.length - res, staging.fileOffset + res);
+    }
+}
+
+void PhysicalDirectWriter::writeFully(const uint8_t *buffer, int length, std::int64_t fileOffset) {
+    while (length > 0) {
+        ssize_t written = pwrite(fd, buffer, length, fileOffset);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::runtime_error("Failed to write file: " + path + ", " + std::strerror(errno));
+        }
+        buffer += written;
+        length -= written;
+        fileOffset += written;
+    }
+}
+
+void PhysicalDirectWriter::flush() {
+    // the content is staged until a buffer is full, O_DIRECT can only write whole blocks
+}
+
+void PhysicalDirectWriter::close() {
+    if (fd < 0) {
+        return;
+    }
+    for (auto &staging : buffers) {
+        waitFor(staging);
+    }
+    // the last partial buffer is written as whole blocks, and the file is truncated afterwards
+    int tail = static_cast<int>(position - bufferStart);
+    if (tail > 0) {
+        int padded = (tail + blockSize - 1) / blockSize * blockSize;
+        uint8_t *pointer = buffers[current].buffer->getPointer();
+        memset(pointer + tail, 0, padded - tail);
+        writeFully(pointer, padded, bufferStart);
+        if (ftruncate(fd, position) != 0) {
+            throw std::runtime_error("Failed to truncate file: " + path + ", " + std::strerror(errno));
+        }
+    }
+    if (ConfigFactory::Instance().boolCheckProperty("localfs.write.fdatasync") && fdatasync(fd) != 0) {
+        throw std::runtime_error("Failed to sync file: " + path + ", " + std::strerror(errno));
+    }
+    ::close(fd);
+    fd = -1;
+    if (ring != nullptr) {
+        io_uring_queue_exit(ring);
+        delete ring;
+        ring = nullptr;
+    }
+}
+
+std::string PhysicalDirectWriter::getPath() const {
+    return path;
+}
+
+int PhysicalDirectWriter::getBufferSize() const {
+    return bufferSize;
+}
@@ -24,35 +24,73 @@
 
 #include "physical/storage/PhysicalLocalWriter.h"
 #include "utils/Constants.h"
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
 
 PhysicalLocalWriter::PhysicalLocalWriter(const std::string &path, bool overwrite) {
     this->position = 0;
     this->path = path;
-    this->rawWriter.open(this->path, overwrite ? std::ios::trunc : std::ios::app);
-    if (!this->rawWriter.is_open()) {
+    this->fd = open(this->path.c_str(), O_WRONLY | O_CREAT | (overwrite ? O_TRUNC : O_APPEND), 0644);
+    if (this->fd < 0) {
         throw std::runtime_error("Failed to open file: " + this->path);
     }
 }
 
+PhysicalLocalWriter::~PhysicalLocalWriter() {
+    close();
+}
+
 std::int64_t PhysicalLocalWriter::prepare(int length) {
     return position;
 }
 
 std::int64_t PhysicalLocalWriter::append(const uint8_t *buffer, int offset, int length) {
+    struct iovec iov{const_cast<uint8_t *>(buffer + offset), static_cast<size_t>(length)};
+    return append(std::vector<struct iovec>{iov});
+}
+
+std::int64_t PhysicalLocalWriter::append(const std::vector<struct iovec> &buffers) {
     std::int64_t start = position;
-    rawWriter.write(reinterpret_cast<const char *>(buffer + offset), length);
-    position += length;
+    std::vector<struct iovec> pending(buffers);
+    size_t first = 0;
+    while (first < pending.size()) {
+        int count = static_cast<int>(std::min<size_t>(pending.size() - first, IOV_MAX));
+        ssize_t written = writev(fd, pending.data() + first, count);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::runtime_error("Failed to write file: " + path + ", " + std::strerror(errno));
+        }
+        position += written;
+        // skip the fully written buffers and continue from the middle of a partially written one
+        while (first < pending.size() && written >= (ssize_t) pending[first].iov_len) {
+            written -= pending[first].iov_len;
+            first++;
+        }
+        if (first < pending.size()) {
+            pending[first].iov_base = static_cast<uint8_t *>(pending[first].iov_base) + written;
+            pending[first].iov_len -= written;
+        }
+    }
     return start;
 }
 
 
 
 void PhysicalLocalWriter::close() {
-    rawWriter.close();
+    if (fd >= 0) {
+        ::close(fd);
+        fd = -1;
+    }
 }
 
 void PhysicalLocalWriter::flush() {
-    rawWriter.flush();
+    // appends are not buffered in user space
 }
 
 std::string PhysicalLocalWriter::getPath() const {
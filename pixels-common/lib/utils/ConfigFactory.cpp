@@ -62,6 +62,10 @@ bool ConfigFactory::boolCheckProperty(std::string key) {
 	}
 }
 
+void ConfigFactory::addProperty(std::string key, std::string value) {
+	prop[key] = value;
+}
+
 std::string ConfigFactory::getPixelsDirectory() {
 	return pixelsHome;
 }
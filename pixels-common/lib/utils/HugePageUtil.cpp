@@ -0,0 +1,92 @@
+//
+// Created by pixels on 10/18/26.
+//
+
+#include "utils/HugePageUtil.h"
+#include "utils/ConfigFactory.h"
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <sys/mman.h>
+
+static size_t roundUpToHugePage(size_t size) {
+    return (size + HugePageUtil::HUGE_PAGE_SIZE - 1) & ~(HugePageUtil::HUGE_PAGE_SIZE - 1);
+}
+
+bool HugePageUtil::isEnabled() {
+    static bool enabled = ConfigFactory::Instance().boolCheckProperty("pixel.hugepage.enable");
+    return enabled;
+}
+
+bool HugePageUtil::isHugeAllocation(size_t size) {
+    return size >= HUGE_PAGE_SIZE && isEnabled();
+}
+
+void * HugePageUtil::mapHugePages(size_t size) {
+    size_t mapped = roundUpToHugePage(size);
+    void * address = mmap(nullptr, mapped, PROT_READ | PROT_WRITE,
+                          MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if(address != MAP_FAILED) {
+        return address;
+    }
+    // the hugetlb pool is empty or not configured. Map one more huge page so that the memory
+    // can be aligned to huge pages, which transparent huge pages require
+    auto * unaligned = (uint8_t *)mmap(nullptr, mapped + HUGE_PAGE_SIZE, PROT_READ | PROT_WRITE,
+                                       MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if(unaligned == MAP_FAILED) {
+        return nullptr;
+    }
+    auto * aligned = (uint8_t *)roundUpToHugePage((uintptr_t)unaligned);
+    if(aligned > unaligned) {
+        munmap(unaligned, aligned - unaligned);
+    }
+    size_t tail = (unaligned + mapped + HUGE_PAGE_SIZE) - (aligned + mapped);
+    if(tail > 0) {
+        munmap(aligned + mapped, tail);
+    }
+    madvise(aligned, mapped, MADV_HUGEPAGE);
+    return aligned;
+}
+
+void * HugePageUtil::allocateAligned(size_t alignment, size_t size) {
+    if(isHugeAllocation(size)) {
+        return mapHugePages(size);
+    }
+    void * address = nullptr;
+    if(posix_memalign(&address, alignment, size) != 0) {
+        return nullptr;
+    }
+    return address;
+}
+
+void HugePageUtil::freeAligned(void * address, size_t size) {
+    if(address == nullptr) {
+        return;
+    }
+    if(isHugeAllocation(size)) {
+        munmap(address, roundUpToHugePage(size));
+    } else {
+        free(address);
+    }
+}
+
+void HugePageUtil::freeBuffer(uint8_t * address, uint32_t size) {
+    freeAligned(address, size);
+}
+
+uint64_t HugePageUtil::getHugePagesInUse() {
+    std::ifstream smaps("/proc/self/smaps_rollup");
+    std::string line;
+    uint64_t kiloBytes = 0;
+    while(std::getline(smaps, line)) {
+        if(line.rfind("AnonHugePages:", 0) == 0 || line.rfind("Shared_Hugetlb:", 0) == 0 ||
+           line.rfind("Private_Hugetlb:", 0) == 0) {
+            std::istringstream fields(line.substr(line.find(':') + 1));
+            uint64_t value = 0;
+            fields >> value;
+            kiloBytes += value;
+        }
+    }
+    return kiloBytes * 1024 / HUGE_PAGE_SIZE;
+}
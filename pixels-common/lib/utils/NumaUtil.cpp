@@ -0,0 +1,92 @@
+//
+// Created by pixels on 10/18/26.
+//
+
+#include "utils/NumaUtil.h"
+#include "utils/ConfigFactory.h"
+#include <fstream>
+#include <climits>
+#include <cstdint>
+#include <cstdlib>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/sysmacros.h>
+#ifdef ENABLE_NUMA
+#include <numa.h>
+#include <numaif.h>
+#endif
+
+bool NumaUtil::isEnabled() {
+#ifdef ENABLE_NUMA
+    static bool enabled = ConfigFactory::Instance().boolCheckProperty("localfs.numa.enable") &&
+                          numa_available() >= 0 && numa_max_node() > 0;
+    return enabled;
+#else
+    return false;
+#endif
+}
+
+int NumaUtil::getNodeOfFile(const std::string & path) {
+    if(!isEnabled()) {
+        return -1;
+    }
+    struct stat fileStat{};
+    if(stat(path.c_str(), &fileStat) != 0) {
+        return -1;
+    }
+    std::string link = "/sys/dev/block/" + std::to_string(major(fileStat.st_dev)) + ":" +
+                       std::to_string(minor(fileStat.st_dev));
+    char resolved[PATH_MAX];
+    if(realpath(link.c_str(), resolved) == nullptr) {
+        return -1;
+    }
+    // e.g., /sys/devices/pci0000:00/0000:00:1d.0/0000:3d:00.0/nvme/nvme0/nvme0n1/nvme0n1p1.
+    // The pci device of the disk (or partition) is the closest ancestor with a numa_node
+    std::string dir = resolved;
+    while(dir.size() > std::string("/sys/devices").size()) {
+        std::ifstream numaNode(dir + "/numa_node");
+        int node;
+        if(numaNode >> node) {
+            return node;
+        }
+        dir = dir.substr(0, dir.find_last_of('/'));
+    }
+    return -1;
+}
+
+int NumaUtil::getCurrentNode() {
+#ifdef ENABLE_NUMA
+    if(isEnabled()) {
+        int cpu = sched_getcpu();
+        return cpu < 0 ? -1 : numa_node_of_cpu(cpu);
+    }
+#endif
+    return -1;
+}
+
+void NumaUtil::runOnNode(int node) {
+#ifdef ENABLE_NUMA
+    if(isEnabled()) {
+        numa_run_on_node(node);
+    }
+#endif
+}
+
+void NumaUtil::bindMemory(void * address, size_t size, int node) {
+#ifdef ENABLE_NUMA
+    if(!isEnabled() || node < 0 || node >= (int)sizeof(unsigned long) * 8) {
+        return;
+    }
+    // mbind works on whole pages
+    uintptr_t pageSize = sysconf(_SC_PAGESIZE);
+    uintptr_t start = ((uintptr_t)address + pageSize - 1) & ~(pageSize - 1);
+    uintptr_t end = ((uintptr_t)address + size) & ~(pageSize - 1);
+    if(start >= end) {
+        return;
+    }
+    unsigned long nodeMask = 1UL << node;
+    // MPOL_PREFERRED rather than MPOL_BIND, so that a full node does not fail the scan
+    mbind((void *)start, end - start, MPOL_PREFERRED, &nodeMask, sizeof(nodeMask) * 8, MPOL_MF_MOVE);
+#endif
+}
@@ -0,0 +1,57 @@
+//
+// Created by pixels on 10/18/26.
+//
+
+#include "utils/ThreadPool.h"
+
+ThreadPool::ThreadPool(int threadNum) : stopped(false) {
+    if (threadNum <= 0) {
+        threadNum = std::max(1, (int) std::thread::hardware_concurrency());
+    }
+    for (int i = 0; i < threadNum; i++) {
+        workers.emplace_back(&ThreadPool::work, this);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        stopped = true;
+    }
+    taskAdded.notify_all();
+    for (auto &worker : workers) {
+        worker.join();
+    }
+}
+
+std::future<void> ThreadPool::submit(std::function<void()> task) {
+    std::packaged_task<void()> packaged(std::move(task));
+    auto future = packaged.get_future();
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        tasks.emplace_back(std::move(packaged));
+    }
+    taskAdded.notify_one();
+    return future;
+}
+
+int ThreadPool::getThreadNum() const {
+    return (int) workers.size();
+}
+
+void ThreadPool::work() {
+    while (true) {
+        std::packaged_task<void()> task;
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            taskAdded.wait(guard, [this] { return stopped || !tasks.empty(); });
+            // the remaining tasks are still run, as their futures may be waited for
+            if (tasks.empty()) {
+                return;
+            }
+            task = std::move(tasks.front());
+            tasks.pop_front();
+        }
+        task();
+    }
+}
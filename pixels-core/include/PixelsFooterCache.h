@@ -7,25 +7,72 @@
 
 #include <iostream>
 #include <string>
+#include <list>
+#include <mutex>
+#include <vector>
 #include "pixels-common/pixels.pb.h"
 #include <unordered_map>
 
 using namespace pixels::proto;
-typedef std::unordered_map<std::string, std::shared_ptr<FileTail>> FileTailTable;
-typedef std::unordered_map<std::string, std::shared_ptr<RowGroupFooter>> RGFooterTable;
 
+/**
+ * Cache of parsed file tails and row group footers.
+ *
+ * The cache is split into shards, each guarded by its own mutex and evicting its
+ * least recently used entries once the shard exceeds its share of the byte budget.
+ * Use {@link #Instance()} to share one cache among all scans and queries of the process.
+ * Entries should be keyed by {@link #fileId(std::string)}, so that files with the same
+ * name in different directories, or files rewritten in place, do not collide.
+ */
 class PixelsFooterCache {
 public:
-    PixelsFooterCache();
+    /**
+     * @param capacityBytes the byte budget of the cache, 0 means unbounded
+     */
+    explicit PixelsFooterCache(size_t capacityBytes = 0);
+    static std::shared_ptr<PixelsFooterCache> Instance();
+    /**
+     * @param path the path of a pixels file
+     * @return the cache id of the file, made of its absolute path, modification time and size
+     */
+    static std::string fileId(const std::string& path);
+    /**
+     * @param absolutePath the absolute and normalized path of a pixels file
+     * @param modificationTime the modification time of the file in nanoseconds
+     * @param size the size of the file in bytes
+     * @return the cache id of the file, equal to fileId(path) while the file is unchanged
+     */
+    static std::string fileId(const std::string& absolutePath, int64_t modificationTime, uint64_t size);
     void putFileTail(const std::string& id, std::shared_ptr<FileTail> fileTail);
     bool containsFileTail(const std::string& id);
 	std::shared_ptr<FileTail> getFileTail(const std::string& id);
+    // returns nullptr on a cache miss
+    std::shared_ptr<FileTail> findFileTail(const std::string& id);
     void putRGFooter(const std::string& id, std::shared_ptr<RowGroupFooter> footer);
     bool containsRGFooter(const std::string& id);
 	std::shared_ptr<RowGroupFooter> getRGFooter(const std::string& id);
+    // returns nullptr on a cache miss
+    std::shared_ptr<RowGroupFooter> findRGFooter(const std::string& id);
+    size_t getBytes();
+    void clear();
 private:
-    FileTailTable fileTailCacheMap;
-    RGFooterTable rowGroupFooterCacheMap;
-
+    static const int SHARD_NUM = 16;
+    struct Entry {
+        std::string key;
+        std::shared_ptr<google::protobuf::Message> message;
+        size_t bytes;
+    };
+    struct Shard {
+        std::mutex lock;
+        // the most recently used entry is at the front
+        std::list<Entry> lru;
+        std::unordered_map<std::string, std::list<Entry>::iterator> table;
+        size_t bytes = 0;
+    };
+    Shard & getShard(const std::string& key);
+    void put(const std::string& key, std::shared_ptr<google::protobuf::Message> message);
+    std::shared_ptr<google::protobuf::Message> find(const std::string& key);
+    size_t shardCapacity;
+    std::vector<Shard> shards;
 };
 #endif //PIXELS_PIXELSFOOTERCACHE_H
@@ -0,0 +1,54 @@
+//
+// Created by pixels on 10/18/26.
+//
+
+#ifndef PIXELS_PIXELSMANIFEST_H
+#define PIXELS_PIXELSMANIFEST_H
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "pixels-common/pixels.pb.h"
+
+/**
+ * The manifest of a directory of pixels files.
+ *
+ * It records the size, modification time, row count and file tail of each file in one
+ * protobuf blob stored as {@link #FILE_NAME} in the directory, so that bind, cardinality
+ * estimation and pruning can be served without opening the data files. An entry is only
+ * returned while the size and modification time of its file are unchanged.
+ */
+class PixelsManifest {
+public:
+    static const std::string FILE_NAME;
+    /**
+     * @param directory the directory of pixels files
+     * @return the manifest of the directory, or nullptr if it has none or it cannot be parsed
+     */
+    static std::shared_ptr<PixelsManifest> open(const std::string & directory);
+    /**
+     * Rewrite the manifest of the directory from all the pixels files in it.
+     * @return the number of files in the manifest
+     */
+    static int build(const std::string & directory);
+    /**
+     * Add or refresh the entries of the given files, and drop the entries of files that are
+     * no longer in the directory.
+     */
+    static void update(const std::string & directory, const std::vector<std::string> & files);
+    /**
+     * @param path the path of a file in the directory
+     * @return the entry of the file, or nullptr if it is missing or stale
+     */
+    const pixels::proto::ManifestEntry * find(const std::string & path) const;
+    const pixels::proto::Manifest & getManifest() const;
+private:
+    PixelsManifest(std::string directory, pixels::proto::Manifest manifest);
+    static void createEntry(const std::string & path, pixels::proto::ManifestEntry * entry);
+    static void write(const std::string & directory, const pixels::proto::Manifest & manifest);
+    std::string directory;
+    pixels::proto::Manifest manifest;
+    std::unordered_map<std::string, int> entryIndex;
+};
+#endif //PIXELS_PIXELSMANIFEST_H
@@ -35,6 +35,7 @@ public:
      * @return record reader
      */
     virtual std::shared_ptr<PixelsRecordReader> read(PixelsReaderOption option) = 0;
+	virtual std::shared_ptr<pixels::proto::FileTail> getFileTail() = 0;
 	virtual std::shared_ptr<TypeDescription> getFileSchema() = 0;
 	virtual PixelsVersion::Version getFileVersion() = 0;
 	virtual long getNumberOfRows() = 0;
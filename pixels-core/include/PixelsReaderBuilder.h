@@ -24,6 +24,10 @@ public:
 	PixelsReaderBuilder * setPath(const std::string & path);
 	PixelsReaderBuilder * setPixelsFooterCache(std::shared_ptr<PixelsFooterCache> pixelsFooterCache);
 	std::shared_ptr<PixelsReader> build();
+	/**
+	 * Read and parse the file tail, without checking the footer cache.
+	 */
+	static std::shared_ptr<pixels::proto::FileTail> readFileTail(const std::shared_ptr<PhysicalReader> & fsReader);
 
 private:
     std::shared_ptr<Storage> builderStorage;
@@ -24,6 +24,7 @@ public:
 	                 std::shared_ptr<pixels::proto::FileTail> fileTail,
 	                 std::shared_ptr<PixelsFooterCache> footerCache);
 	~PixelsReaderImpl();
+	std::shared_ptr<pixels::proto::FileTail> getFileTail() override;
 	std::shared_ptr<TypeDescription> getFileSchema() override;
 	PixelsVersion::Version getFileVersion() override;
 	long getNumberOfRows() override;
@@ -45,6 +46,7 @@ private:
 	std::shared_ptr<TypeDescription> fileSchema;
     std::shared_ptr<PhysicalReader> physicalReader;
 	std::shared_ptr<PixelsFooterCache> pixelsFooterCache;
+    std::shared_ptr<pixels::proto::FileTail> fileTail;
     pixels::proto::PostScript postScript;
     pixels::proto::Footer footer;
 	bool closed;
@@ -33,6 +33,10 @@
 #include "stats/StatsRecorder.h"
 #include "pixels-common/pixels.pb.h"
 #include "vector/VectorizedRowBatch.h"
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
 #include <unicode/timezone.h>
 #include <unicode/unistr.h>
 #include <unicode/locid.h>
@@ -42,13 +46,37 @@ public:
     PixelsWriterImpl(std::shared_ptr<TypeDescription> schema, int pixelsStride, int rowGroupSize,
                      const std::string &targetFilePath, int blockSize, bool blockPadding,
                      EncodingLevel encodingLevel, bool nullsPadding,bool partitioned, int compressionBlockSize);
+    ~PixelsWriterImpl() override;
     bool addRowBatch(std::shared_ptr<VectorizedRowBatch> rowBatch) override;
     void writeColumnVectors(std::vector<std::shared_ptr<ColumnVector>> &columnVectors, int rowBatchSize);
+    /**
+     * Hand the current row group over to the I/O stage and start a new one. It blocks while
+     * {@link #FLUSH_QUEUE_SIZE} row groups are still waiting to be written.
+     */
     void writeRowGroup();
     void writeFileTail();
     void close() override;
 
 private:
+    /**
+     * The encoded content of a row group that is waiting to be written by the I/O stage.
+     */
+    struct PendingRowGroup {
+        // the finished column writers, whose output streams are written without copying
+        std::vector<std::shared_ptr<ColumnWriter>> writers;
+        std::vector<pixels::proto::ColumnChunkIndex> chunkIndices;
+        pixels::proto::RowGroupEncoding encoding;
+        pixels::proto::RowGroupStatistic statistic;
+        std::int64_t numOfRows = 0;
+    };
+    // the loop of the I/O stage
+    void flushRowGroups();
+    void writeRowGroupContent(PendingRowGroup &rowGroup);
+    // encode the column vector of column i and record its cost for balancing
+    void writeColumnVector(int i, std::shared_ptr<ColumnVector>& columnVector, int rowBatchSize);
+    void updateRowGroupDataLength();
+    void stopFlushThread();
+
     /**
      * The number of bytes that the start offset of each column chunk is aligned to.
      */
@@ -57,22 +85,35 @@ private:
      * The byte buffer padded to each column chunk for alignment.
      */
     static const std::vector<uint8_t> CHUNK_PADDING_BUFFER;
+    /**
+     * Row batches with fewer rows are encoded by the caller thread alone.
+     */
+    static const int MIN_PARALLEL_BATCH_SIZE;
+    /**
+     * The max number of finished row groups held in memory until they are written.
+     */
+    static const int FLUSH_QUEUE_SIZE;
 
     std::shared_ptr<TypeDescription> schema;
     int rowGroupSize;
+    // a row group is written once its estimated bytes or (if positive) its rows reach these targets
+    std::int64_t rowGroupTargetBytes;
+    std::int64_t rowGroupTargetRows;
     pixels::proto::CompressionKind compressionKind;
     int compressionBlockSize;
     // std::unique_ptr<icu::TimeZone> timeZone;
     std::shared_ptr<PixelsWriterOption> columnWriterOption;
     std::vector<std::shared_ptr<ColumnWriter>> columnWriters;
-    std::vector<StatsRecorder> fileColStatRecorders;
-    std::int64_t fileContentLength;
-    int fileRowNum;
+    // the estimated bytes each column added for the last row batch, to balance the encoding groups
+    std::vector<int> columnCosts;
+    std::vector<std::unique_ptr<StatsRecorder>> fileColStatRecorders;
+    std::int64_t fileContentLength = 0;
+    int fileRowNum = 0;
     std::int64_t writtenBytes = 0;
     std::int64_t curRowGroupOffset = 0;
     std::int64_t curRowGroupFooterOffset = 0;
     std::int64_t curRowGroupNumOfRows = 0;
-    int curRowGroupDataLength = 0;
+    std::int64_t curRowGroupDataLength = 0;
     bool haseValueIsSet = false;
     int currHashValue = 0;
     bool partitioned;
@@ -80,6 +121,15 @@ private:
     std::vector<pixels::proto::RowGroupStatistic> rowGroupStatisticList;
     std::shared_ptr<PhysicalWriter> physicalWriter;
     std::vector<std::shared_ptr<TypeDescription>> children;
+    // the I/O stage, it owns the physical writer and the row group information until close
+    std::thread flushThread;
+    std::deque<std::shared_ptr<PendingRowGroup>> flushQueue;
+    std::mutex flushLock;
+    std::condition_variable flushQueueChanged;
+    bool flushStopped = false;
+    std::exception_ptr flushError;
+    // the column writers of the row groups that have been written, waiting to be reset and reused
+    std::vector<std::vector<std::shared_ptr<ColumnWriter>>> spareColumnWriters;
 
 };
 #endif //PIXELS_PIXELSWRITERIMPL_H
@@ -38,6 +38,15 @@ public:
     void encode(int* values, int offset, int length, byte* results, int& resultLength);
     void encode(long* values, byte* results, int length, int& resultLength);
     void encode(int* values, byte* results, int length, int& resultLength);
+    /**
+     * Encode the values and append them to the output stream. The output stream is reserved for
+     * maxEncodedLength(length) bytes first, so that the runs are written into it without growing it
+     * or copying them through an intermediate buffer.
+     */
+    void encode(const long* values, int length, std::shared_ptr<ByteBuffer> output);
+    void encode(const int* values, int length, std::shared_ptr<ByteBuffer> output);
+    // the max number of bytes that length values are encoded into
+    static uint32_t maxEncodedLength(int length);
     // -----------------------------------------------------------
     void determineEncoding();
     // -----------------------------------------------------------
@@ -27,6 +27,8 @@ public:
     duckdb::TableFilterSet * getFilter();
     int getRGStart();
     int getRGLen();
+    void setRGSelection(const std::vector<bool> & selection);
+    const std::vector<bool> & getRGSelection() const;
     int getBatchSize() const;
     void setTolerantSchemaEvolution(bool t);
     bool isTolerantSchemaEvolution();
@@ -44,5 +46,6 @@ private:
     int batchSize;
     int rgStart;
     int rgLen;
+    std::vector<bool> rgSelection;  // empty means all row groups in [rgStart, rgStart + rgLen) are read
 };
 #endif //PIXELS_PIXELSREADEROPTION_H
@@ -46,9 +46,16 @@ public:
                                     std::shared_ptr<PixelsFooterCache> pixelsFooterCache
                                     );
     void asyncReadComplete(int requestSize);
+    /**
+     * Wait for all the submitted async reads, including those left behind by an error. It does not throw.
+     * @return false if the reads can't be waited for, so that their buffers must not be reused
+     */
+    bool asyncReadDrain();
     std::shared_ptr<VectorizedRowBatch> readBatch(bool reuse) override;
 	std::shared_ptr<TypeDescription> getResultSchema() override;
     bool read();
+    // whether read() is invoked for the current row group
+    bool isEverRead();
 	std::shared_ptr<PixelsBitMask> getFilterMask();
 	bool isEndOfFile() override;
     ~PixelsRecordReaderImpl();
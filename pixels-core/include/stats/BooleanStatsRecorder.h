@@ -0,0 +1,28 @@
+//
+// Created by pixels on 10/19/26.
+//
+
+#ifndef PIXELS_BOOLEANSTATSRECORDER_H
+#define PIXELS_BOOLEANSTATSRECORDER_H
+
+#include "stats/StatsRecorder.h"
+
+/**
+ * The statistics of boolean columns, serialized as a bucket holding the number of true values.
+ */
+class BooleanStatsRecorder : public StatsRecorder {
+public:
+    BooleanStatsRecorder();
+    explicit BooleanStatsRecorder(const pixels::proto::ColumnStatistic& statistic);
+
+    void updateBoolean(bool value, int repetitions) override;
+    // the values are 0 or 1, as in the byte column vector of boolean columns
+    void updateBoolean(const uint8_t* values, int length);
+    void merge(const StatsRecorder& stats) override;
+    void reset() override;
+    pixels::proto::ColumnStatistic serialize() const override;
+
+private:
+    long trueCount;
+};
+#endif // PIXELS_BOOLEANSTATSRECORDER_H
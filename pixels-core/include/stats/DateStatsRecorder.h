@@ -0,0 +1,29 @@
+//
+// Created by pixels on 10/19/26.
+//
+
+#ifndef PIXELS_DATESTATSRECORDER_H
+#define PIXELS_DATESTATSRECORDER_H
+
+#include "stats/StatsRecorder.h"
+
+/**
+ * The statistics of date columns, in days since the epoch.
+ */
+class DateStatsRecorder : public StatsRecorder {
+public:
+    DateStatsRecorder();
+    explicit DateStatsRecorder(const pixels::proto::ColumnStatistic& statistic);
+
+    void updateDate(int value) override;
+    void updateDate(const int* values, int length) override;
+    void merge(const StatsRecorder& stats) override;
+    void reset() override;
+    pixels::proto::ColumnStatistic serialize() const override;
+
+private:
+    int minimum;
+    int maximum;
+    bool hasMinimum;
+};
+#endif // PIXELS_DATESTATSRECORDER_H
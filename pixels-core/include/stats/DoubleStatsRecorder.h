@@ -0,0 +1,31 @@
+//
+// Created by pixels on 10/19/26.
+//
+
+#ifndef PIXELS_DOUBLESTATSRECORDER_H
+#define PIXELS_DOUBLESTATSRECORDER_H
+
+#include "stats/StatsRecorder.h"
+
+/**
+ * The statistics of float and double columns.
+ */
+class DoubleStatsRecorder : public StatsRecorder {
+public:
+    DoubleStatsRecorder();
+    explicit DoubleStatsRecorder(const pixels::proto::ColumnStatistic& statistic);
+
+    void updateFloat(float value) override;
+    void updateDouble(double value) override;
+    void updateDouble(const double* values, int length) override;
+    void merge(const StatsRecorder& stats) override;
+    void reset() override;
+    pixels::proto::ColumnStatistic serialize() const override;
+
+private:
+    double minimum;
+    double maximum;
+    double sum;
+    bool hasMinimum;
+};
+#endif // PIXELS_DOUBLESTATSRECORDER_H
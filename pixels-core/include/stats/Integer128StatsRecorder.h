@@ -0,0 +1,28 @@
+//
+// Created by pixels on 10/19/26.
+//
+
+#ifndef PIXELS_INTEGER128STATSRECORDER_H
+#define PIXELS_INTEGER128STATSRECORDER_H
+
+#include "stats/StatsRecorder.h"
+
+/**
+ * The statistics of long decimal columns, whose unscaled values are 128-bit integers.
+ */
+class Integer128StatsRecorder : public StatsRecorder {
+public:
+    Integer128StatsRecorder();
+    explicit Integer128StatsRecorder(const pixels::proto::ColumnStatistic& statistic);
+
+    void updateInteger128(long high, long low, int repetitions) override;
+    void merge(const StatsRecorder& stats) override;
+    void reset() override;
+    pixels::proto::ColumnStatistic serialize() const override;
+
+private:
+    __int128 minimum;
+    __int128 maximum;
+    bool hasMinimum;
+};
+#endif // PIXELS_INTEGER128STATSRECORDER_H
@@ -0,0 +1,32 @@
+//
+// Created by pixels on 10/19/26.
+//
+
+#ifndef PIXELS_INTEGERSTATSRECORDER_H
+#define PIXELS_INTEGERSTATSRECORDER_H
+
+#include "stats/StatsRecorder.h"
+
+/**
+ * The statistics of byte, short, int, long and short decimal columns. The sum is not
+ * serialized once it overflows.
+ */
+class IntegerStatsRecorder : public StatsRecorder {
+public:
+    IntegerStatsRecorder();
+    explicit IntegerStatsRecorder(const pixels::proto::ColumnStatistic& statistic);
+
+    void updateInteger(long value, int repetitions) override;
+    void updateInteger(const long* values, int length) override;
+    void merge(const StatsRecorder& stats) override;
+    void reset() override;
+    pixels::proto::ColumnStatistic serialize() const override;
+
+private:
+    long minimum;
+    long maximum;
+    long sum;
+    bool hasMinimum;
+    bool overflow;
+};
+#endif // PIXELS_INTEGERSTATSRECORDER_H
@@ -53,10 +53,22 @@ public:
     virtual void updateTime(int value);
     virtual void updateTimestamp(long value);
     virtual void updateVector();
+    /**
+     * Update the statistics with the non-null values of a pixel at once. The type-specific
+     * recorders reduce them in branch-free loops that the compiler vectorizes.
+     */
+    virtual void updateInteger(const long* values, int length);
+    virtual void updateDouble(const double* values, int length);
+    virtual void updateDate(const int* values, int length);
+    virtual void updateTime(const int* values, int length);
+    virtual void updateTimestamp(const long* values, int length);
+    // update with a string that is not null-terminated, e.g., a view into a column vector
+    virtual void updateString(const char* value, int length, int repetitions);
 
     bool isStatsExists() const;
-    void merge(const StatsRecorder& stats);
-    void reset();
+    // merge the statistics of a recorder of the same type, or only its counts otherwise
+    virtual void merge(const StatsRecorder& stats);
+    virtual void reset();
 
     long getNumberOfValues() const;
     bool hasNullValue() const;
@@ -0,0 +1,31 @@
+//
+// Created by pixels on 10/19/26.
+//
+
+#ifndef PIXELS_STRINGSTATSRECORDER_H
+#define PIXELS_STRINGSTATSRECORDER_H
+
+#include "stats/StatsRecorder.h"
+
+/**
+ * The statistics of string, varchar and char columns. The sum is the total length of the values.
+ */
+class StringStatsRecorder : public StatsRecorder {
+public:
+    StringStatsRecorder();
+    explicit StringStatsRecorder(const pixels::proto::ColumnStatistic& statistic);
+
+    void updateString(const std::string& value, int repetitions) override;
+    // update with a value that is not null-terminated, without copying it unless it is a new bound
+    void updateString(const char* value, int length, int repetitions) override;
+    void merge(const StatsRecorder& stats) override;
+    void reset() override;
+    pixels::proto::ColumnStatistic serialize() const override;
+
+private:
+    std::string minimum;
+    std::string maximum;
+    long sum;
+    bool hasMinimum;
+};
+#endif // PIXELS_STRINGSTATSRECORDER_H
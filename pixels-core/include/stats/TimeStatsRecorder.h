@@ -0,0 +1,29 @@
+//
+// Created by pixels on 10/19/26.
+//
+
+#ifndef PIXELS_TIMESTATSRECORDER_H
+#define PIXELS_TIMESTATSRECORDER_H
+
+#include "stats/StatsRecorder.h"
+
+/**
+ * The statistics of time columns, in milliseconds of the day.
+ */
+class TimeStatsRecorder : public StatsRecorder {
+public:
+    TimeStatsRecorder();
+    explicit TimeStatsRecorder(const pixels::proto::ColumnStatistic& statistic);
+
+    void updateTime(int value) override;
+    void updateTime(const int* values, int length) override;
+    void merge(const StatsRecorder& stats) override;
+    void reset() override;
+    pixels::proto::ColumnStatistic serialize() const override;
+
+private:
+    int minimum;
+    int maximum;
+    bool hasMinimum;
+};
+#endif // PIXELS_TIMESTATSRECORDER_H
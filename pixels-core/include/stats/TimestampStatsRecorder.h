@@ -0,0 +1,29 @@
+//
+// Created by pixels on 10/19/26.
+//
+
+#ifndef PIXELS_TIMESTAMPSTATSRECORDER_H
+#define PIXELS_TIMESTAMPSTATSRECORDER_H
+
+#include "stats/StatsRecorder.h"
+
+/**
+ * The statistics of timestamp columns, in the unit of the timestamp column vector.
+ */
+class TimestampStatsRecorder : public StatsRecorder {
+public:
+    TimestampStatsRecorder();
+    explicit TimestampStatsRecorder(const pixels::proto::ColumnStatistic& statistic);
+
+    void updateTimestamp(long value) override;
+    void updateTimestamp(const long* values, int length) override;
+    void merge(const StatsRecorder& stats) override;
+    void reset() override;
+    pixels::proto::ColumnStatistic serialize() const override;
+
+private:
+    long minimum;
+    long maximum;
+    bool hasMinimum;
+};
+#endif // PIXELS_TIMESTAMPSTATSRECORDER_H
@@ -42,6 +42,8 @@ public:
       * <b>DO NOT</b> modify it or used it as the number of values in-used.
       */
     uint64_t length;
+    // the number of values the data array is allocated for, which resize() does not change
+    uint64_t capacity;
     uint64_t writeIndex;
     uint64_t readIndex;
     uint64_t memoryUsage;
@@ -45,27 +45,50 @@ public:
     /**
      * Write values from input buffers
      *
+     * @return the number of bytes encoded into the output stream by this call
      */
     virtual int write(std::shared_ptr<ColumnVector> columnVector,int length )=0;
 
+    // a copy of the column chunk, prefer getColumnChunkPointer() and getColumnChunkSize()
     virtual std::vector<uint8_t> getColumnChunkContent() const;
+    // the column chunk in the output stream of this writer, valid until the writer is reset or written
+    virtual const uint8_t *getColumnChunkPointer() const;
     virtual int getColumnChunkSize() const;
+    /**
+     * @return the size of the column chunk if it was flushed now, i.e., the encoded pixels, the isNull
+     * bitmaps, and the values of the current pixel estimated by the bytes per value of the encoded pixels
+     */
+    virtual int getEstimatedChunkSize() const;
     virtual bool decideNullsPadding(std::shared_ptr<PixelsWriterOption> writerOption) =0;
     virtual pixels::proto::ColumnChunkIndex getColumnChunkIndex();
     virtual std::shared_ptr<pixels::proto::ColumnChunkIndex> getColumnChunkIndexPtr();
     virtual pixels::proto::ColumnEncoding getColumnChunkEncoding() const ; 
+    // the statistics of the pixels written into the current column chunk
+    const StatsRecorder& getColumnChunkStatRecorder() const;
+    pixels::proto::ColumnStatistic getColumnChunkStat() const;
+    // prepare the writer for the next row group, keeping the memory it has allocated
     virtual void reset();
     virtual void flush() ;
     virtual void close() ;
 
     // virtual
     virtual void newPixel();
+protected:
+    /**
+     * @return true if at most one in NEARLY_SORTED_DESCENTS adjacent values descends. Such values
+     * have long monotonic runs, so that they are delta encoded well by RunLenIntEncoder.
+     */
+    template <typename T>
+    static bool isNearlySorted(const T* values, int length);
+    // for the writers whose encodings always pad the nulls, regardless of the writer option
+    ColumnWriter(std::shared_ptr<TypeDescription> type, std::shared_ptr<PixelsWriterOption> writerOption,
+                 bool nullsPadding);
 private:
     static const int ISNULL_ALIGNMENT;
+    static const int NEARLY_SORTED_DESCENTS = 16;
     static const std::vector<uint8_t> ISNULL_PADDING_BUFFER;
 
     std::shared_ptr<pixels::proto::ColumnChunkIndex> columnChunkIndex{};
-    std::shared_ptr<pixels::proto::ColumnStatistic> columnChunkStat{};
 
     int lastPixelPosition = 0;
     int curPixelPosition = 0;
@@ -78,12 +101,23 @@ protected:
     std::shared_ptr<ByteBuffer> outputStream;
     int curPixelEleIndex = 0;
 //std::unique_ptr<Encoder> encoder;
-    StatsRecorder pixelStatRecorder;
-    StatsRecorder columnChunkStatRecorder;
+    std::unique_ptr<StatsRecorder> pixelStatRecorder;
+    std::unique_ptr<StatsRecorder> columnChunkStatRecorder;
 bool hasNull = false;
     const bool nullsPadding;
     int curPixelVectorIndex = 0;
+    // the number of values encoded into the output stream in the current column chunk
+    long encodedValueNum = 0;
     const ByteOrder byteOrder;
     std::vector<bool> isNull{};
 };
+
+template <typename T>
+bool ColumnWriter::isNearlySorted(const T* values, int length) {
+    int descents = 0;
+    for (int i = 1; i < length; i++) {
+        descents += values[i] < values[i - 1];
+    }
+    return descents * NEARLY_SORTED_DESCENTS <= length;
+}
 #endif //PIXELS_COLUMNWRITER_H
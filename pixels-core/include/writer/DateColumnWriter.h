@@ -28,21 +28,30 @@
 #include "ColumnWriter.h"
 #include "encoding/RunLenIntEncoder.h"
 
+/**
+ * The writer of date columns. The values are the days from 1970-1-1.
+ *
+ * At the EL2 encoding level, a column chunk is run length encoded if the values of its first pixel are
+ * nearly sorted, otherwise it is plain little-endian ints. The nulls are always padded, as
+ * DateColumnReader reads one value for each row.
+ */
 class DateColumnWriter : public ColumnWriter{
 public:
     DateColumnWriter(std::shared_ptr<TypeDescription> type, std::shared_ptr<PixelsWriterOption> writerOption);
 
     int write(std::shared_ptr<ColumnVector> vector, int length) override;
     void close() override;
+    void reset() override;
     void newPixel() override;
     void writeCurPartTime(std::shared_ptr<ColumnVector> columnVector, int* values, int curPartLength, int curPartOffset);
     bool decideNullsPadding(std::shared_ptr<PixelsWriterOption> writerOption) override;
-    pixels::proto::ColumnEncoding getColumnChunkEncoding() const;
+    pixels::proto::ColumnEncoding getColumnChunkEncoding() const override;
 
 private:
     bool runlengthEncoding;
+    bool useRunLength = false; // whether the current column chunk is run length encoded
     std::unique_ptr<RunLenIntEncoder> encoder;
-    std::vector<long> curPixelVector; // current pixel value vector haven't written out yet
+    std::vector<int> curPixelVector; // current pixel value vector haven't written out yet
 
 };
 #endif // DUCKDB_DATECOLUMNWRITER_H
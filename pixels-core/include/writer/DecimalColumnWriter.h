@@ -27,12 +27,22 @@
 #include "encoding/RunLenIntEncoder.h"
 #include "ColumnWriter.h"
 #include "utils/EncodingUtils.h"
+#include "vector/DecimalColumnVector.h"
 
+/**
+ * The writer of short decimal columns, i.e., the decimals whose precision is not greater than
+ * TypeDescription::SHORT_DECIMAL_MAX_PRECISION. The unscaled values are written as plain little-endian
+ * longs, because DecimalColumnReader reads them in place. The nulls are always padded.
+ */
 class DecimalColumnWriter :public  ColumnWriter{
 public:
     DecimalColumnWriter(std::shared_ptr<TypeDescription> type,std::shared_ptr<PixelsWriterOption> writerOption);
     int write(std::shared_ptr<ColumnVector> vector, int length) override;
+    void newPixel() override;
+    void writeCurPartDecimal(std::shared_ptr<DecimalColumnVector> columnVector, int curPartLength, int curPartOffset);
     bool decideNullsPadding(std::shared_ptr<PixelsWriterOption> writerOption) override;
+private:
+    std::vector<long> curPixelVector; // current pixel value vector haven't written out yet
 };
 
 #endif //DUCKDB_DECIMALCOLUMNWRITER_H
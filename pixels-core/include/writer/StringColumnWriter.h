@@ -30,35 +30,67 @@
 #include "utils/EncodingUtils.h"
 #include "encoding/RunLenIntEncoder.h"
 
+/**
+ * The writer of string, varchar and char columns.
+ *
+ * Each column chunk is dictionary encoded by default: the values are looked up in a per column chunk
+ * dictionary, and the codes of the values are written in pixels, run length encoded if the encoding level
+ * is EL2. The dictionary content and the starts of the keys are written after the isNull bitmap. If the
+ * first pixel of a column chunk has too many distinct values, the chunk falls back to the plain content of
+ * the values followed by their starts. The nulls are always padded, as StringColumnReader expects.
+ */
 class StringColumnWriter : public ColumnWriter {
+public:
   StringColumnWriter(std::shared_ptr<TypeDescription> type,std::shared_ptr<PixelsWriterOption> writerOption);
 
   // vector should be converted to BinaryColumnVector
   int write(std::shared_ptr<ColumnVector> vector,int length) override;
   void close() override;
-  void newPixels() ;
+  void reset() override;
+  void newPixel() override;
 
   bool decideNullsPadding(std::shared_ptr<PixelsWriterOption> writerOption) override;
 
-  void writeCurPartWithoutDict(std::shared_ptr<PixelsWriterOption> writerOption,uint8_t ** values,
-                               int* vLens,int* vOffsets,int curPartLength,int curPartOffset);
+  void writeCurPartWithDict(duckdb::string_t* values,uint8_t* valueIsNull,int curPartLength,int curPartOffset);
+
+  void writeCurPartWithoutDict(duckdb::string_t* values,uint8_t* valueIsNull,int curPartLength,int curPartOffset);
 
   void flush() override;
 
-  pixels::proto::ColumnEncoding getColumnChunkEncoding();
+  int getEstimatedChunkSize() const override;
+
+  pixels::proto::ColumnEncoding getColumnChunkEncoding() const override;
 
   void flushStarts();
 
+  void flushDictionary();
 
   private:
-    std::vector<long> curPixelVector;
+    static const double DICTIONARY_THRESHOLD;
+    static const int INITIAL_DICTIONARY_SLOTS = 1024;
+    // @return the code of the value, the value is added to the dictionary if it is new
+    int addToDictionary(const char* value,int length);
+    void growDictionary();
+    void clearDictionary();
+    // rewrite the codes of the current pixel as plain content and starts, and drop the dictionary
+    void fallBackToPlain();
+    void writeInts(const long* values,int length,bool useRunLength);
+
+    std::vector<long> curPixelVector; // the codes of the current pixel haven't written out yet
     bool runlengthEncoding;
     bool dictionaryEncoding;
+    bool useDictionary; // whether the current column chunk is dictionary encoded
     std::shared_ptr<DynamicIntArray> startsArray;
     std::shared_ptr<EncodingUtils>  encodingUtils;
   std::unique_ptr<RunLenIntEncoder> encoder;
   int  startOffset=0;
-
-
+  /*
+   * The dictionary is an open addressing hash table with linear probing. The slots hold the codes
+   * of the keys, and the keys are views into dictContent, in the order of their codes.
+   */
+  std::vector<int> dictSlots;
+  std::vector<size_t> dictHashes; // the hash of each key, indexed by the code
+  std::vector<long> dictStarts; // the start of each key in dictContent, and the end of the last key
+  std::vector<char> dictContent;
 };
 #endif // DUCKDB_STRINGCOLUMNWRITER_H
@@ -27,18 +27,27 @@
 #include "ColumnWriter.h"
 #include "encoding/RunLenIntEncoder.h"
 
+/**
+ * The writer of timestamp columns. The values are the timestamps of the column vector in its precision.
+ *
+ * At the EL2 encoding level, a column chunk is run length encoded if the values of its first pixel are
+ * nearly sorted, otherwise it is plain little-endian longs. The nulls are always padded, as
+ * TimestampColumnReader reads one value for each row.
+ */
 class TimestampColumnWriter : public ColumnWriter{
 public:
     TimestampColumnWriter(std::shared_ptr<TypeDescription> type, std::shared_ptr<PixelsWriterOption> writerOption);
 
     int write(std::shared_ptr<ColumnVector> vector, int length) override;
     void close() override;
+    void reset() override;
     void newPixel() override;
     void writeCurPartTimestamp(std::shared_ptr<ColumnVector> columnVector, long* values, int curPartLength, int curPartOffset);
     bool decideNullsPadding(std::shared_ptr<PixelsWriterOption> writerOption) override;
-    pixels::proto::ColumnEncoding getColumnChunkEncoding() const;
+    pixels::proto::ColumnEncoding getColumnChunkEncoding() const override;
 private:
     bool runlengthEncoding;
+    bool useRunLength = false; // whether the current column chunk is run length encoded
     std::unique_ptr<RunLenIntEncoder> encoder;
     std::vector<long> curPixelVector; // current pixel value vector haven't written out yet
 
@@ -3,40 +3,128 @@
 //
 #include "PixelsFooterCache.h"
 #include "exception/InvalidArgumentException.h"
+#include "utils/ConfigFactory.h"
+#include <filesystem>
+#include <sys/stat.h>
 
-PixelsFooterCache::PixelsFooterCache() {
+PixelsFooterCache::PixelsFooterCache(size_t capacityBytes) : shards(SHARD_NUM) {
+    shardCapacity = capacityBytes / SHARD_NUM;
+    if(capacityBytes > 0 && shardCapacity == 0) {
+        shardCapacity = 1;
+    }
+}
+
+std::shared_ptr<PixelsFooterCache> PixelsFooterCache::Instance() {
+    static std::shared_ptr<PixelsFooterCache> instance = std::make_shared<PixelsFooterCache>(
+            std::stoul(ConfigFactory::Instance().getProperty("pixel.footer.cache.size")));
+    return instance;
+}
+
+std::string PixelsFooterCache::fileId(const std::string& path) {
+    std::string absolutePath = std::filesystem::absolute(path).lexically_normal().string();
+    struct stat fileStat{};
+    if(stat(absolutePath.c_str(), &fileStat) != 0) {
+        return absolutePath;
+    }
+    return fileId(absolutePath, (int64_t)fileStat.st_mtim.tv_sec * 1000000000L + fileStat.st_mtim.tv_nsec,
+                  fileStat.st_size);
+}
+
+std::string PixelsFooterCache::fileId(const std::string& absolutePath, int64_t modificationTime, uint64_t size) {
+    return absolutePath + "@" + std::to_string(modificationTime) + ":" + std::to_string(size);
+}
+
+PixelsFooterCache::Shard & PixelsFooterCache::getShard(const std::string& key) {
+    return shards.at(std::hash<std::string>{}(key) % SHARD_NUM);
+}
+
+void PixelsFooterCache::put(const std::string& key, std::shared_ptr<google::protobuf::Message> message) {
+    size_t bytes = message->SpaceUsedLong() + key.size();
+    Shard & shard = getShard(key);
+    std::lock_guard<std::mutex> guard(shard.lock);
+    auto it = shard.table.find(key);
+    if(it != shard.table.end()) {
+        shard.bytes -= it->second->bytes;
+        shard.lru.erase(it->second);
+        shard.table.erase(it);
+    }
+    shard.lru.push_front(Entry{key, std::move(message), bytes});
+    shard.table[key] = shard.lru.begin();
+    shard.bytes += bytes;
+    // keep the new entry even if it alone exceeds the budget of the shard
+    while(shardCapacity > 0 && shard.bytes > shardCapacity && shard.lru.size() > 1) {
+        Entry & victim = shard.lru.back();
+        shard.bytes -= victim.bytes;
+        shard.table.erase(victim.key);
+        shard.lru.pop_back();
+    }
+}
+
+std::shared_ptr<google::protobuf::Message> PixelsFooterCache::find(const std::string& key) {
+    Shard & shard = getShard(key);
+    std::lock_guard<std::mutex> guard(shard.lock);
+    auto it = shard.table.find(key);
+    if(it == shard.table.end()) {
+        return nullptr;
+    }
+    shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+    return it->second->message;
 }
 
 void PixelsFooterCache::putFileTail(const std::string& id, std::shared_ptr<FileTail> fileTail) {
-    fileTailCacheMap[id] = fileTail;
+    put("T:" + id, std::move(fileTail));
+}
+
+std::shared_ptr<FileTail> PixelsFooterCache::findFileTail(const std::string& id) {
+    return std::static_pointer_cast<FileTail>(find("T:" + id));
 }
 
 std::shared_ptr<FileTail> PixelsFooterCache::getFileTail(const std::string& id) {
-    if(fileTailCacheMap.find(id) != fileTailCacheMap.end()) {
-        return fileTailCacheMap[id];
-    } else {
+    auto fileTail = findFileTail(id);
+    if(fileTail == nullptr) {
         throw InvalidArgumentException("No such a FileTail id.");
     }
+    return fileTail;
+}
+
+bool PixelsFooterCache::containsFileTail(const std::string &id) {
+    return findFileTail(id) != nullptr;
 }
 
 void PixelsFooterCache::putRGFooter(const std::string& id, std::shared_ptr<RowGroupFooter> footer) {
-    rowGroupFooterCacheMap[id] = footer;
+    put("R:" + id, std::move(footer));
 }
 
-bool PixelsFooterCache::containsFileTail(const std::string &id) {
-    return fileTailCacheMap.find(id) != fileTailCacheMap.end();
+std::shared_ptr<RowGroupFooter> PixelsFooterCache::findRGFooter(const std::string& id) {
+    return std::static_pointer_cast<RowGroupFooter>(find("R:" + id));
 }
 
 std::shared_ptr<RowGroupFooter> PixelsFooterCache::getRGFooter(const std::string& id) {
-    if(rowGroupFooterCacheMap.find(id) != rowGroupFooterCacheMap.end()) {
-        return rowGroupFooterCacheMap[id];
-    } else {
+    auto footer = findRGFooter(id);
+    if(footer == nullptr) {
         throw InvalidArgumentException("No such a RGFooter id.");
     }
+    return footer;
 }
 
 bool PixelsFooterCache::containsRGFooter(const std::string &id) {
-    return rowGroupFooterCacheMap.find(id) != rowGroupFooterCacheMap.end();
+    return findRGFooter(id) != nullptr;
 }
 
+size_t PixelsFooterCache::getBytes() {
+    size_t bytes = 0;
+    for(auto & shard : shards) {
+        std::lock_guard<std::mutex> guard(shard.lock);
+        bytes += shard.bytes;
+    }
+    return bytes;
+}
 
+void PixelsFooterCache::clear() {
+    for(auto & shard : shards) {
+        std::lock_guard<std::mutex> guard(shard.lock);
+        shard.table.clear();
+        shard.lru.clear();
+        shard.bytes = 0;
+    }
+}
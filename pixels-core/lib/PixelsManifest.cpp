@@ -0,0 +1,157 @@
+//
+// Created by pixels on 10/18/26.
+//
+
+#include "PixelsManifest.h"
+#include "PixelsReaderBuilder.h"
+#include "physical/PhysicalReaderUtil.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+const std::string PixelsManifest::FILE_NAME = "_pixels.manifest";
+
+static std::string withTrailingSlash(const std::string & directory) {
+    if(!directory.empty() && directory.back() == '/') {
+        return directory;
+    }
+    return directory + "/";
+}
+
+static std::string fileNameOf(const std::string & path) {
+    return path.substr(path.find_last_of('/') + 1);
+}
+
+static std::string withoutScheme(std::string path) {
+    if(path.rfind("file://", 0) != std::string::npos) {
+        path.erase(0, 7);
+    }
+    return path;
+}
+
+PixelsManifest::PixelsManifest(std::string directory, pixels::proto::Manifest manifest)
+        : directory(std::move(directory)), manifest(std::move(manifest)) {
+    for(int i = 0; i < this->manifest.entries_size(); i++) {
+        entryIndex[this->manifest.entries(i).filename()] = i;
+    }
+}
+
+std::shared_ptr<PixelsManifest> PixelsManifest::open(const std::string & directory) {
+    std::string path = withTrailingSlash(directory) + FILE_NAME;
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if(fd < 0) {
+        return nullptr;
+    }
+    struct stat fileStat{};
+    if(fstat(fd, &fileStat) != 0 || fileStat.st_size == 0) {
+        ::close(fd);
+        return nullptr;
+    }
+    void * blob = mmap(nullptr, fileStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if(blob == MAP_FAILED) {
+        return nullptr;
+    }
+    pixels::proto::Manifest manifest;
+    bool parsed = manifest.ParseFromArray(blob, (int)fileStat.st_size);
+    munmap(blob, fileStat.st_size);
+    if(!parsed) {
+        std::cerr << "PixelsManifest: ignore the corrupted manifest " << path << std::endl;
+        return nullptr;
+    }
+    return std::shared_ptr<PixelsManifest>(new PixelsManifest(withTrailingSlash(directory), std::move(manifest)));
+}
+
+const pixels::proto::ManifestEntry * PixelsManifest::find(const std::string & path) const {
+    auto it = entryIndex.find(fileNameOf(path));
+    if(it == entryIndex.end()) {
+        return nullptr;
+    }
+    const pixels::proto::ManifestEntry & entry = manifest.entries(it->second);
+    struct stat fileStat{};
+    if(stat(withoutScheme(path).c_str(), &fileStat) != 0) {
+        return nullptr;
+    }
+    int64_t modificationTime = (int64_t)fileStat.st_mtim.tv_sec * 1000000000L + fileStat.st_mtim.tv_nsec;
+    if(entry.filesize() != (uint64_t)fileStat.st_size || entry.modificationtime() != modificationTime) {
+        return nullptr;
+    }
+    return &entry;
+}
+
+const pixels::proto::Manifest & PixelsManifest::getManifest() const {
+    return manifest;
+}
+
+void PixelsManifest::createEntry(const std::string & path, pixels::proto::ManifestEntry * entry) {
+    struct stat fileStat{};
+    if(stat(path.c_str(), &fileStat) != 0) {
+        throw std::runtime_error("PixelsManifest: cannot stat " + path);
+    }
+    std::shared_ptr<PhysicalReader> reader = PhysicalReaderUtil::newPhysicalReader(Storage::file, path);
+    std::shared_ptr<pixels::proto::FileTail> fileTail = PixelsReaderBuilder::readFileTail(reader);
+    reader->close();
+    entry->set_filename(fileNameOf(path));
+    entry->set_filesize(fileStat.st_size);
+    entry->set_modificationtime((int64_t)fileStat.st_mtim.tv_sec * 1000000000L + fileStat.st_mtim.tv_nsec);
+    entry->set_numberofrows(fileTail->postscript().numberofrows());
+    *entry->mutable_filetail() = *fileTail;
+}
+
+void PixelsManifest::write(const std::string & directory, const pixels::proto::Manifest & manifest) {
+    std::string path = withTrailingSlash(directory) + FILE_NAME;
+    std::string tmpPath = path + ".tmp";
+    {
+        std::ofstream output(tmpPath, std::ios::binary | std::ios::trunc);
+        if(!output.is_open() || !manifest.SerializeToOstream(&output)) {
+            throw std::runtime_error("PixelsManifest: failed to write " + tmpPath);
+        }
+    }
+    // readers see either the old or the new manifest
+    if(std::rename(tmpPath.c_str(), path.c_str()) != 0) {
+        throw std::runtime_error("PixelsManifest: failed to rename " + tmpPath + " to " + path);
+    }
+}
+
+int PixelsManifest::build(const std::string & directory) {
+    std::vector<std::string> files;
+    for(const auto & dirEntry : std::filesystem::directory_iterator(withoutScheme(directory))) {
+        if(dirEntry.is_regular_file() && dirEntry.path().extension() == ".pxl") {
+            files.emplace_back(dirEntry.path().string());
+        }
+    }
+    std::sort(files.begin(), files.end());
+    pixels::proto::Manifest manifest;
+    for(const auto & file : files) {
+        createEntry(file, manifest.add_entries());
+    }
+    write(withoutScheme(directory), manifest);
+    return (int)files.size();
+}
+
+void PixelsManifest::update(const std::string & directory, const std::vector<std::string> & files) {
+    std::string dir = withTrailingSlash(withoutScheme(directory));
+    std::map<std::string, pixels::proto::ManifestEntry> entries;
+    auto existing = open(dir);
+    if(existing != nullptr) {
+        for(const auto & entry : existing->getManifest().entries()) {
+            if(std::filesystem::exists(dir + entry.filename())) {
+                entries[entry.filename()] = entry;
+            }
+        }
+    }
+    for(const auto & file : files) {
+        std::string path = withoutScheme(file);
+        createEntry(path, &entries[fileNameOf(path)]);
+    }
+    pixels::proto::Manifest manifest;
+    for(auto & entry : entries) {
+        *manifest.add_entries() = std::move(entry.second);
+    }
+    write(dir, manifest);
+}
@@ -25,6 +25,29 @@ PixelsReaderBuilder * PixelsReaderBuilder::setPixelsFooterCache(std::shared_ptr<
     return this;
 }
 
+std::shared_ptr<pixels::proto::FileTail> PixelsReaderBuilder::readFileTail(
+        const std::shared_ptr<PhysicalReader> & fsReader) {
+    long fileLen = fsReader->getFileLength();
+    fsReader->seek(fileLen - (long)sizeof(long));
+    long SmallEndianFileTailOffset = fsReader->readLong();
+    long BigEndianFileTailOffset=(long)__builtin_bswap64(SmallEndianFileTailOffset);
+    long fileTailOffset=0;
+    if(SmallEndianFileTailOffset<0){
+        fileTailOffset=BigEndianFileTailOffset;
+    }else{
+        fileTailOffset=SmallEndianFileTailOffset;
+    }
+    int fileTailLength = (int) (fileLen - fileTailOffset - sizeof(long));
+    fsReader->seek(fileTailOffset);
+    std::shared_ptr<ByteBuffer> fileTailBuffer = fsReader->readFully(fileTailLength);
+    auto fileTail = std::make_shared<pixels::proto::FileTail>();
+    if(!fileTail->ParseFromArray(fileTailBuffer->getPointer(),
+                                fileTailLength)) {
+        throw InvalidArgumentException("PixelsReaderBuilder::build: paring FileTail error!");
+    }
+    return fileTail;
+}
+
 std::shared_ptr<PixelsReader> PixelsReaderBuilder::build() {
     if(builderStorage.get() == nullptr || builderPath.empty()) {
         throw std::runtime_error("Missing argument to build PixelsReader");
@@ -33,38 +56,19 @@ std::shared_ptr<PixelsReader> PixelsReaderBuilder::build() {
     std::shared_ptr<PhysicalReader> fsReader =
 	    PhysicalReaderUtil::newPhysicalReader(builderStorage, builderPath);
     // try to get file tail from cache
-    std::string fileName = fsReader->getName();
+    std::string fileId = PixelsFooterCache::fileId(fsReader->getPath());
     std::shared_ptr<pixels::proto::FileTail> fileTail;
-    if(builderPixelsFooterCache != nullptr && builderPixelsFooterCache->containsFileTail(fileName)) {
-        fileTail = builderPixelsFooterCache->getFileTail(fileName);
-    } else {
+    if(builderPixelsFooterCache != nullptr) {
+        fileTail = builderPixelsFooterCache->findFileTail(fileId);
+    }
+    if(fileTail == nullptr) {
         if(fsReader.get() == nullptr) {
             throw PixelsReaderException(
                     "Failed to create PixelsReader due to error of creating PhysicalReader");
         }
-        // get FileTail
-        long fileLen = fsReader->getFileLength();
-        std::cout<<"filelen: "<<fsReader->getFileLength()<<std::endl;
-        fsReader->seek(fileLen - (long)sizeof(long));
-		long SmallEndianFileTailOffset = fsReader->readLong();
-        long BigEndianFileTailOffset=(long)__builtin_bswap64(SmallEndianFileTailOffset);
-        long fileTailOffset=0;
-        if(SmallEndianFileTailOffset<0){
-            fileTailOffset=BigEndianFileTailOffset;
-        }else{
-            fileTailOffset=SmallEndianFileTailOffset;
-        }
-        std::cout<<"fileTailOffset: "<<fileTailOffset<<std::endl;
-        int fileTailLength = (int) (fileLen - fileTailOffset - sizeof(long));
-        fsReader->seek(fileTailOffset);
-        std::shared_ptr<ByteBuffer> fileTailBuffer = fsReader->readFully(fileTailLength);
-		fileTail = std::make_shared<pixels::proto::FileTail>();
-        if(!fileTail->ParseFromArray(fileTailBuffer->getPointer(),
-                                    fileTailLength)) {
-            throw InvalidArgumentException("PixelsReaderBuilder::build: paring FileTail error!");
-        }
+        fileTail = readFileTail(fsReader);
 		if(builderPixelsFooterCache != nullptr) {
-			builderPixelsFooterCache->putFileTail(fileName, fileTail);
+			builderPixelsFooterCache->putFileTail(fileId, fileTail);
 		}
     }
 
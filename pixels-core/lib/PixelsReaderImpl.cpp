@@ -10,6 +10,7 @@ PixelsReaderImpl::PixelsReaderImpl(std::shared_ptr<TypeDescription> fileSchema,
                                    std::shared_ptr<PixelsFooterCache> footerCache) {
 	this->fileSchema = fileSchema;
 	this->physicalReader = reader;
+	this->fileTail = fileTail;
 	this->footer = fileTail->footer();
 	this->postScript = fileTail->postscript();
 	this->pixelsFooterCache = footerCache;
@@ -32,6 +33,10 @@ std::shared_ptr<PixelsRecordReader> PixelsReaderImpl::read(PixelsReaderOption op
     recordReaders.emplace_back(recordReader);
     return recordReader;
 }
+std::shared_ptr<pixels::proto::FileTail> PixelsReaderImpl::getFileTail() {
+	return fileTail;
+}
+
 std::shared_ptr<TypeDescription> PixelsReaderImpl::getFileSchema() {
 	return fileSchema;
 }
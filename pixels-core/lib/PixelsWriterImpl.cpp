@@ -27,6 +27,10 @@
 #include "encoding/EncodingLevel.h"
 #include <string>
 #include <future>
+#include <limits>
+#include <numeric>
+#include "exception/InvalidArgumentException.h"
+#include "utils/ThreadPool.h"
 #include "writer/ColumnWriterBuilder.h"
 #include "pixels-common/pixels.pb.h"
 #include "ColumnWriterBuilder.h"
@@ -38,6 +42,10 @@
 
 const int PixelsWriterImpl::CHUNK_ALIGNMENT = std::stoi(ConfigFactory::Instance().getProperty("column.chunk.alignment"));
 
+const int PixelsWriterImpl::MIN_PARALLEL_BATCH_SIZE = 64;
+
+const int PixelsWriterImpl::FLUSH_QUEUE_SIZE = std::stoi(ConfigFactory::Instance().getProperty("pixel.writer.flush.queue.size"));
+
 const std::vector<uint8_t> PixelsWriterImpl::CHUNK_PADDING_BUFFER = std::vector<uint8_t>(CHUNK_ALIGNMENT, 0);
 
 PixelsWriterImpl::PixelsWriterImpl(std::shared_ptr<TypeDescription> schema, int pixelsStride, int rowGroupSize,
@@ -53,50 +61,131 @@ PixelsWriterImpl::PixelsWriterImpl(std::shared_ptr<TypeDescription> schema, int
 
     for(int i=0;i<children.size();i++){
         columnWriters.push_back(ColumnWriterBuilder::newColumnWriter(children.at(i),columnWriterOption));
+        fileColStatRecorders.push_back(StatsRecorder::create(*children.at(i)));
+    }
+
+    std::string target = ConfigFactory::Instance().getProperty("row.group.target");
+    this->rowGroupTargetRows = 0;
+    if(target == "size"){
+        this->rowGroupTargetBytes = rowGroupSize;
+    } else if(target == "rows"){
+        this->rowGroupTargetRows = std::stol(ConfigFactory::Instance().getProperty("row.group.rows"));
+        this->rowGroupTargetBytes = std::numeric_limits<int>::max();
+    } else if(target == "reader"){
+        // a scan thread holds the row group it reads and the one it prefetches in its scan buffers
+        std::int64_t budget = std::stoll(ConfigFactory::Instance().getProperty("pixel.bufferpool.max.size"));
+        int threads = std::stoi(ConfigFactory::Instance().getProperty("pixel.threads"));
+        if(threads <= 0){
+            threads = std::max(1, (int) std::thread::hardware_concurrency());
+        }
+        this->rowGroupTargetBytes = budget > 0 ? budget / threads / 2 : rowGroupSize;
+        this->rowGroupTargetBytes = std::min<std::int64_t>(rowGroupTargetBytes, std::numeric_limits<int>::max());
+    } else {
+        throw InvalidArgumentException("PixelsWriterImpl: unknown row.group.target " + target);
     }
+    this->flushThread = std::thread(&PixelsWriterImpl::flushRowGroups, this);
 }
 
 bool PixelsWriterImpl::addRowBatch(std::shared_ptr<VectorizedRowBatch> rowBatch) {
-    std::cout << "PixelsWriterImpl::addRowBatch" << std::endl;
-    curRowGroupDataLength=0;
     curRowGroupNumOfRows+=rowBatch->count();
     writeColumnVectors(rowBatch->cols,rowBatch->count());
 
-    if(curRowGroupDataLength>=rowGroupSize){
+    if(curRowGroupDataLength>=rowGroupTargetBytes||
+       (rowGroupTargetRows>0&&curRowGroupNumOfRows>=rowGroupTargetRows)){
         writeRowGroup();
         curRowGroupNumOfRows=0L;
+        curRowGroupDataLength=0;
         return false;
     }
     return true;
 }
 
+/**
+ * The workers shared by all the writers of the process to encode column vectors.
+ */
+static ThreadPool & encodePool() {
+    static ThreadPool pool(std::stoi(ConfigFactory::Instance().getProperty("pixel.writer.encode.threads")));
+    return pool;
+}
+
 void PixelsWriterImpl::writeColumnVectors(std::vector<std::shared_ptr<ColumnVector>>& columnVectors, int rowBatchSize)
 {
-    std::vector<std::future<void>> futures;
-    std::atomic<int> dataLength(0);
-    int commonColumnLength = columnVectors.size() ;
-
-    // Writing regular columns
-    for (int i = 0; i < commonColumnLength; ++i) {
-       // dataLength += columnWriters[i]->write(columnVectors[i], rowBatchSize);
-       futures.emplace_back(std::async(std::launch::async, [this, columnVectors, rowBatchSize, i, &dataLength]() {
-           try {
-               dataLength += columnWriters[i]->write(columnVectors[i], rowBatchSize);
-           } catch (const std::exception& e) {
-               throw std::runtime_error("failed to write column vector: " + std::string(e.what()));
-           }
-       }));
+    int commonColumnLength = columnVectors.size();
+    if (columnCosts.size() != commonColumnLength) {
+        columnCosts.assign(commonColumnLength, 1);
+    }
+    // the caller thread encodes one group itself
+    int groupNum = std::min(commonColumnLength, encodePool().getThreadNum() + 1);
+    if (groupNum <= 1 || rowBatchSize < MIN_PARALLEL_BATCH_SIZE) {
+        for (int i = 0; i < commonColumnLength; ++i) {
+            writeColumnVector(i, columnVectors[i], rowBatchSize);
+        }
+        updateRowGroupDataLength();
+        return;
     }
 
+    // assign the largest columns (by the bytes of their last batch) first, each to the least loaded group
+    std::vector<int> order(commonColumnLength);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [this](int a, int b) { return columnCosts[a] > columnCosts[b]; });
+    std::vector<std::vector<int>> groups(groupNum);
+    std::vector<int64_t> groupCosts(groupNum, 0);
+    for (int i : order) {
+        int target = std::min_element(groupCosts.begin(), groupCosts.end()) - groupCosts.begin();
+        groups[target].push_back(i);
+        groupCosts[target] += std::max(columnCosts[i], 1);
+    }
 
-    // Wait for all futures to complete
+    auto encodeGroup = [this, &columnVectors, rowBatchSize](const std::vector<int> &group) {
+        for (int i : group) {
+            try {
+                writeColumnVector(i, columnVectors[i], rowBatchSize);
+            } catch (const std::exception& e) {
+                throw std::runtime_error("failed to write column vector: " + std::string(e.what()));
+            }
+        }
+    };
+    std::vector<std::future<void>> futures;
+    for (int g = 1; g < groupNum; ++g) {
+        futures.emplace_back(encodePool().submit([&encodeGroup, &groups, g]() { encodeGroup(groups[g]); }));
+    }
+    std::exception_ptr error;
+    try {
+        encodeGroup(groups[0]);
+    } catch (...) {
+        error = std::current_exception();
+    }
+    // wait for all the groups even on failure, as they reference the column vectors of this batch
     for (auto& future : futures) {
-        future.get();  // Blocking until all tasks are completed
+        try {
+            future.get();
+        } catch (...) {
+            if (!error) {
+                error = std::current_exception();
+            }
+        }
+    }
+    if (error) {
+        std::rethrow_exception(error);
     }
 
-    // Simulate curRowGroupDataLength accumulation
-    curRowGroupDataLength += dataLength.load();
-    std::cout << "Data length written: " << curRowGroupDataLength << std::endl;
+    updateRowGroupDataLength();
+}
+
+void PixelsWriterImpl::writeColumnVector(int i, std::shared_ptr<ColumnVector>& columnVector, int rowBatchSize)
+{
+    int before = columnWriters[i]->getEstimatedChunkSize();
+    columnWriters[i]->write(columnVector, rowBatchSize);
+    columnCosts[i] = columnWriters[i]->getEstimatedChunkSize() - before;
+}
+
+void PixelsWriterImpl::updateRowGroupDataLength()
+{
+    // the encoded and the estimated pending bytes of all the columns in the current row group
+    curRowGroupDataLength = 0;
+    for (const auto& writer : columnWriters) {
+        curRowGroupDataLength += writer->getEstimatedChunkSize();
+    }
 }
 
 void PixelsWriterImpl::close(){
@@ -104,6 +193,10 @@ void PixelsWriterImpl::close(){
         if(curRowGroupNumOfRows!=0){
             writeRowGroup();
         }
+        stopFlushThread();
+        if(flushError){
+            std::rethrow_exception(flushError);
+        }
         writeFileTail();
         physicalWriter->close();
         for(auto cw:columnWriters){
@@ -116,19 +209,112 @@ void PixelsWriterImpl::close(){
     }
 }
 
+PixelsWriterImpl::~PixelsWriterImpl() {
+    stopFlushThread();
+}
+
+void PixelsWriterImpl::stopFlushThread() {
+    {
+        std::lock_guard<std::mutex> guard(flushLock);
+        flushStopped = true;
+    }
+    flushQueueChanged.notify_all();
+    if(flushThread.joinable()){
+        flushThread.join();
+    }
+}
+
 void PixelsWriterImpl::writeRowGroup() {
-    // TODO
-    std::cout<<"Try to write rowGroup"<<std::endl;
+    // hand the finished column writers to the I/O stage, so that other writers can accept row
+    // batches while it writes this row group
+    auto rowGroup = std::make_shared<PendingRowGroup>();
+    rowGroup->numOfRows = curRowGroupNumOfRows;
+    for(int i=0;i<columnWriters.size();i++){
+        const auto& writer=columnWriters[i];
+        // flush writes the isNull bit map into the internal output stream.
+        writer->flush();
+        rowGroup->chunkIndices.emplace_back(writer->getColumnChunkIndex());
+        *(rowGroup->encoding.add_columnchunkencodings()) = writer->getColumnChunkEncoding();
+        *(rowGroup->statistic.add_columnchunkstats()) = writer->getColumnChunkStat();
+        fileColStatRecorders[i]->merge(writer->getColumnChunkStatRecorder());
+    }
+    rowGroup->writers.swap(columnWriters);
+
+    std::vector<std::shared_ptr<ColumnWriter>> spare;
+    {
+        std::unique_lock<std::mutex> guard(flushLock);
+        // backpressure: wait until the I/O stage catches up
+        flushQueueChanged.wait(guard, [this] { return flushQueue.size() < FLUSH_QUEUE_SIZE || flushError; });
+        if(flushError){
+            std::rethrow_exception(flushError);
+        }
+        flushQueue.push_back(std::move(rowGroup));
+        if(!spareColumnWriters.empty()){
+            spare.swap(spareColumnWriters.back());
+            spareColumnWriters.pop_back();
+        }
+    }
+    flushQueueChanged.notify_all();
+
+    // continue with the writers of a row group that has been written, or new writers if all are in use
+    if(!spare.empty()){
+        columnWriters.swap(spare);
+        for(const auto& writer:columnWriters){
+            writer->reset();
+        }
+    }else{
+        for(int i=0;i<children.size();i++){
+            columnWriters.push_back(ColumnWriterBuilder::newColumnWriter(children.at(i),columnWriterOption));
+        }
+    }
+}
+
+void PixelsWriterImpl::flushRowGroups() {
+    while(true){
+        std::shared_ptr<PendingRowGroup> rowGroup;
+        {
+            std::unique_lock<std::mutex> guard(flushLock);
+            flushQueueChanged.wait(guard, [this] { return flushStopped || !flushQueue.empty(); });
+            if(flushQueue.empty()){
+                return;
+            }
+            // keep the row group in the queue while it is written, so that it counts against the queue size
+            rowGroup = flushQueue.front();
+        }
+        try{
+            writeRowGroupContent(*rowGroup);
+        }
+        catch (const std::exception& e){
+            std::cerr <<e.what()<<std::endl;
+            std::lock_guard<std::mutex> guard(flushLock);
+            flushError = std::current_exception();
+            flushQueue.clear();
+            flushQueueChanged.notify_all();
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> guard(flushLock);
+            flushQueue.pop_front();
+        }
+        flushQueueChanged.notify_all();
+    }
+}
+
+void PixelsWriterImpl::writeRowGroupContent(PendingRowGroup &rowGroup) {
     int rowGroupDataLength = 0;
-//    pixels::proto::RowGroupStatistic curRowGroupStatistic;
     pixels::proto::RowGroupInformation curRowGroupInfo;
     pixels::proto::RowGroupIndex curRowGroupIndex;
-    pixels::proto::RowGroupEncoding curRowGroupEncoding;
-    // reset each column writer and get current row group content size in bytes
-    for(auto writer:columnWriters){
-        // flush writes the isNull bit map into the internal output stream.
-        writer->flush();
-        rowGroupDataLength+=writer->getColumnChunkSize();
+    // lay out the column chunks and their alignment padding
+    std::vector<struct iovec> buffers;
+    for(int i=0;i<rowGroup.writers.size();i++){
+        auto& writer=rowGroup.writers[i];
+        int chunkSize=writer->getColumnChunkSize();
+        auto& chunkIndex=rowGroup.chunkIndices[i];
+        chunkIndex.set_chunkoffset(rowGroupDataLength);
+        chunkIndex.set_chunklength(chunkSize);
+        chunkIndex.set_littleendian(true);
+        buffers.push_back({const_cast<uint8_t*>(writer->getColumnChunkPointer()), static_cast<size_t>(chunkSize)});
+        rowGroupDataLength+=chunkSize;
         if(CHUNK_ALIGNMENT!=0&& rowGroupDataLength%CHUNK_ALIGNMENT!=0){
             /*
             * Issue #519:
@@ -136,103 +322,73 @@ void PixelsWriterImpl::writeRowGroup() {
             * has to determine whether to start a new block, if the current block
             * is not large enough.
             */
-            rowGroupDataLength+=CHUNK_ALIGNMENT-rowGroupDataLength%CHUNK_ALIGNMENT;
+            int alignBytes=CHUNK_ALIGNMENT-rowGroupDataLength%CHUNK_ALIGNMENT;
+            buffers.push_back({const_cast<uint8_t*>(CHUNK_PADDING_BUFFER.data()), static_cast<size_t>(alignBytes)});
+            rowGroupDataLength+=alignBytes;
         }
     }
-    // write and flush row group content
-    try{
-        curRowGroupOffset=physicalWriter->prepare(rowGroupDataLength);
-        if(curRowGroupOffset!=-1){
-            int tryAlign=0;
-            while(CHUNK_ALIGNMENT!=0&&curRowGroupOffset%CHUNK_ALIGNMENT!=0&&tryAlign++<2){
-                int alignBytes=CHUNK_ALIGNMENT-curRowGroupOffset%CHUNK_ALIGNMENT;
-                physicalWriter->append(CHUNK_PADDING_BUFFER.data(), 0, alignBytes);
-                writtenBytes += alignBytes;
-                curRowGroupOffset = physicalWriter->prepare(rowGroupDataLength);
-            }
-            if(tryAlign>2){
-                std::cerr << "Failed to align the start offset of the column chunks in the row group" << std::endl;
-                throw std::runtime_error("Failed to align the start offset of the column chunks in the row group");
-            }
-
-            for(auto& writer:columnWriters){
-                auto rowGroupBuffer=writer->getColumnChunkContent();
-                physicalWriter->append(rowGroupBuffer.data(), 0, rowGroupBuffer.size());
-                writtenBytes += rowGroupBuffer.size();
-                if (CHUNK_ALIGNMENT != 0 && rowGroupBuffer.size() % CHUNK_ALIGNMENT != 0) {
-                    int alignBytes = CHUNK_ALIGNMENT - rowGroupBuffer.size() % CHUNK_ALIGNMENT;
-                    physicalWriter->append(CHUNK_PADDING_BUFFER.data(), 0, alignBytes);
-                    writtenBytes += alignBytes;
-                }
-            }
-            physicalWriter->flush();
-        }else{
-            std::cerr << "Write row group prepare failed" << std::endl;
-            throw std::runtime_error("Write row group prepare failed");
-        }
+    // reserve room for aligning the start offset of the row group as well
+    curRowGroupOffset=physicalWriter->prepare(rowGroupDataLength+CHUNK_ALIGNMENT);
+    if(curRowGroupOffset==-1){
+        throw std::runtime_error("Write row group prepare failed");
     }
-    catch (const std::exception& e){
-        std::cerr <<e.what()<<std::endl;
-        throw;
+    if(CHUNK_ALIGNMENT!=0&&curRowGroupOffset%CHUNK_ALIGNMENT!=0){
+        int alignBytes=CHUNK_ALIGNMENT-curRowGroupOffset%CHUNK_ALIGNMENT;
+        buffers.insert(buffers.begin(), {const_cast<uint8_t*>(CHUNK_PADDING_BUFFER.data()), static_cast<size_t>(alignBytes)});
+        writtenBytes += alignBytes;
+        curRowGroupOffset += alignBytes;
     }
+    // write row group content in one append
+    physicalWriter->append(buffers);
+    writtenBytes += rowGroupDataLength;
 
-
-    // update index and stats(necessary?)
-    rowGroupDataLength=0;
-    for(int i=0;i<columnWriters.size();i++){
-        std::shared_ptr<ColumnWriter> writer=columnWriters[i];
-        auto chunkIndex=writer->getColumnChunkIndex();
-        chunkIndex.set_chunkoffset(curRowGroupOffset+rowGroupDataLength);
-        chunkIndex.set_chunklength(writer->getColumnChunkSize());
-        chunkIndex.set_littleendian(true);
-        rowGroupDataLength+=writer->getColumnChunkSize();
-        if(CHUNK_ALIGNMENT!=0&&rowGroupDataLength%CHUNK_ALIGNMENT!=0){
-            rowGroupDataLength += CHUNK_ALIGNMENT - rowGroupDataLength % CHUNK_ALIGNMENT;
-        }
+    for(auto& chunkIndex:rowGroup.chunkIndices){
+        chunkIndex.set_chunkoffset(curRowGroupOffset+chunkIndex.chunkoffset());
         *(curRowGroupIndex.add_columnchunkindexentries()) = chunkIndex;
-        *(curRowGroupEncoding.add_columnchunkencodings()) = writer->getColumnChunkEncoding();
-
-
-        columnWriters[i]=ColumnWriterBuilder::newColumnWriter(children.at(i),columnWriterOption);
+    }
+    // the output streams are no longer needed, the writers are reused by a later row group
+    {
+        std::lock_guard<std::mutex> guard(flushLock);
+        spareColumnWriters.emplace_back(std::move(rowGroup.writers));
     }
 
     // put curRowGroupIndex into rowGroupFooter
     std::shared_ptr<pixels::proto::RowGroupFooter> rowGroupFooter=std::make_shared<pixels::proto::RowGroupFooter>();
 
     rowGroupFooter->mutable_rowgroupindexentry()->CopyFrom(curRowGroupIndex);
-    rowGroupFooter->mutable_rowgroupencoding()->CopyFrom(curRowGroupEncoding);
-    std::cout<<"curRowGroupEncoding: "<<curRowGroupEncoding.ByteSizeLong()<<std::endl;
-    std::cout<<"curRowGroupEncoding: "<<curRowGroupEncoding.ByteSizeLong()<<std::endl;
-    try {
-        ByteBuffer footerBuffer(rowGroupFooter->ByteSizeLong());
-        rowGroupFooter->SerializeToArray(footerBuffer.getPointer(), rowGroupFooter->ByteSizeLong());
-        physicalWriter->prepare(footerBuffer.size());
-        curRowGroupFooterOffset = physicalWriter->append(footerBuffer.getPointer(), 0, footerBuffer.size());
-        writtenBytes += footerBuffer.size();
-        physicalWriter->flush();
-    } catch (const std::exception& e) {
-        std::cerr << e.what() << std::endl;
-        throw;
-    }
+    rowGroupFooter->mutable_rowgroupencoding()->CopyFrom(rowGroup.encoding);
+    ByteBuffer footerBuffer(rowGroupFooter->ByteSizeLong());
+    rowGroupFooter->SerializeToArray(footerBuffer.getPointer(), rowGroupFooter->ByteSizeLong());
+    physicalWriter->prepare(footerBuffer.size());
+    curRowGroupFooterOffset = physicalWriter->append(footerBuffer.getPointer(), 0, footerBuffer.size());
+    writtenBytes += footerBuffer.size();
+    // one flush per row group, for both the content and the footer
+    physicalWriter->flush();
     // Update RowGroupInformation and add it to the list
     curRowGroupInfo.set_footeroffset(curRowGroupFooterOffset);
     curRowGroupInfo.set_datalength(rowGroupDataLength);
     curRowGroupInfo.set_footerlength(rowGroupFooter->ByteSizeLong());
-    curRowGroupInfo.set_numberofrows(curRowGroupNumOfRows);
+    curRowGroupInfo.set_numberofrows(rowGroup.numOfRows);
     rowGroupInfoList.push_back(curRowGroupInfo);
+    rowGroupStatisticList.push_back(std::move(rowGroup.statistic));
 
-    this->fileRowNum += curRowGroupNumOfRows;
+    this->fileRowNum += rowGroup.numOfRows;
     this->fileContentLength += rowGroupDataLength;
-    std::cout << "PixelsWriterImpl::writeRowGroup" << std::endl;
 }
 
 void PixelsWriterImpl::writeFileTail() {
     std::shared_ptr<pixels::proto::Footer> footer=std::make_shared<pixels::proto::Footer>();
     std::shared_ptr<pixels::proto::PostScript> postScript=std::make_shared<pixels::proto::PostScript>();
     schema->writeTypes(footer);
+    for(const auto& recorder: fileColStatRecorders){
+        *(footer->add_columnstats()) = recorder->serialize();
+    }
     for(auto rowGroupInformation: rowGroupInfoList){
         *(footer->add_rowgroupinfos()) = rowGroupInformation;
     }
+    for(const auto& rowGroupStatistic: rowGroupStatisticList){
+        *(footer->add_rowgroupstats()) = rowGroupStatistic;
+    }
     postScript->set_version(PixelsVersion::V1);
     std::string FILE_MAGIC="PIXELS";
     postScript->set_contentlength(fileContentLength);
@@ -253,17 +409,13 @@ void PixelsWriterImpl::writeFileTail() {
 
     // flush filetail
     int fileTailLen=fileTail.ByteSizeLong()+8;
-    std::cout<<"fileTailLen:"<<fileTailLen<<std::endl;
     physicalWriter->prepare(fileTailLen);
     std::shared_ptr<ByteBuffer> fileTailBuffer=std::make_shared<ByteBuffer>(fileTail.ByteSizeLong());
     fileTail.SerializeToArray(fileTailBuffer->getPointer(),fileTail.ByteSizeLong());
     long tailOffset =physicalWriter->append(fileTailBuffer->getPointer(),0,fileTail.ByteSizeLong());
-    std::cout<<"fileTailOffset:"<<tailOffset<<std::endl;
     std::shared_ptr<ByteBuffer> tailOffsetBuffer=std::make_shared<ByteBuffer>(8);
     tailOffsetBuffer->putLong(tailOffset);
     physicalWriter->append(tailOffsetBuffer);
     writtenBytes+=fileTailLen;
     physicalWriter->flush();
-
-    std::cout << "PixelsWriterImpl::writeFileTail" << std::endl;
 }
\ No newline at end of file
@@ -14,6 +14,10 @@
 
 #include <memory>
 
+// PENDING: RunLenIntDecoder does not decode PATCHED_BASE yet, so the values that
+//          should be patched are DIRECT encoded until it does
+static constexpr bool ENABLE_PATCHED_BASE = false;
+
 // -----------------------------------------------------------
 // Construtors 
 
@@ -86,7 +90,7 @@ void RunLenIntEncoder::encode(int* values, int offset, int length, byte* results
     flush();
     resLen = outputStream->getWritePos();
     outputStream->getBytes(results, resLen);
-    outputStream->clear();
+    outputStream->resetPosition();
 }
 
 void RunLenIntEncoder::encode(long* values, byte* results, int length, int& resLen) {
@@ -97,6 +101,44 @@ void RunLenIntEncoder::encode(int* values, byte* results, int length, int& resLe
     encode(values, 0, length, results, resLen);
 }
 
+void RunLenIntEncoder::encode(const long* values, int length, std::shared_ptr<ByteBuffer> output) {
+    output->reserve(maxEncodedLength(length));
+    // write the runs straight into the output stream instead of the buffer of the encoder
+    std::shared_ptr<ByteBuffer> buffer = outputStream;
+    outputStream = std::move(output);
+    try {
+        for(int i = 0; i < length; ++i) {
+            this->write(values[i]);
+        }
+        flush();
+    } catch (...) {
+        outputStream = std::move(buffer);
+        throw;
+    }
+    outputStream = std::move(buffer);
+}
+
+void RunLenIntEncoder::encode(const int* values, int length, std::shared_ptr<ByteBuffer> output) {
+    output->reserve(maxEncodedLength(length));
+    std::shared_ptr<ByteBuffer> buffer = outputStream;
+    outputStream = std::move(output);
+    try {
+        for(int i = 0; i < length; ++i) {
+            this->write(values[i]);
+        }
+        flush();
+    } catch (...) {
+        outputStream = std::move(buffer);
+        throw;
+    }
+    outputStream = std::move(buffer);
+}
+
+uint32_t RunLenIntEncoder::maxEncodedLength(int length) {
+    // a run is never encoded into more than twice the plain size of its values, the headers included
+    return (uint32_t) length * sizeof(long) * 2 + 16;
+}
+
 
 // -----------------------------------------------------------
 
@@ -224,7 +266,7 @@ void RunLenIntEncoder::determineEncoding() {
         // fallback to DIRECT encoding.
         // The decision to use patched base was based on zigzag values, but the
         // actual patching is done on base reduced literals.
-        if(brBits100p - brBits95p != 0) {
+        if(ENABLE_PATCHED_BASE && brBits100p - brBits95p != 0) {
             // std::cout << "brBits100p - brBits95p != 0" << std::endl;
             encodingType = EncodingType::PATCHED_BASE;
             preparePatchedBlob();
@@ -853,7 +895,7 @@ int RunLenIntEncoder::percentileBits(long*  data, int offset, int length, double
         return -1;
     }
 
-    int hist[32];
+    int hist[32] = {0};
     for(int i = offset; i < (offset + length); ++i) {
         // QUESTION: there is calling of getClosestFixedBits in encodeBitWidth function, 
         //           is it redundant here to call it? maybe just count is enough
@@ -972,7 +1014,7 @@ void RunLenIntEncoder::writeVulong(std::shared_ptr<ByteBuffer> output, long valu
         }
         else {
             output->put((byte) (0x80 | (value & 0x7f)));
-            value = ((unsigned)value) >> 7;
+            value = ((unsigned long)value) >> 7;
         }
     }
 }
@@ -53,6 +53,14 @@ int PixelsReaderOption::getRGLen() {
     return rgLen;
 }
 
+void PixelsReaderOption::setRGSelection(const std::vector<bool> & selection) {
+    rgSelection = selection;
+}
+
+const std::vector<bool> & PixelsReaderOption::getRGSelection() const {
+    return rgSelection;
+}
+
 void PixelsReaderOption::setTolerantSchemaEvolution(bool t) {
     tolerantSchemaEvolution = t;
 }
@@ -249,9 +249,12 @@ void PixelsRecordReaderImpl::prepareRead() {
 
     uint64_t includedRowNum = 0;
     // read row group statistics and find target row groups
+    const std::vector<bool> & rgSelection = option.getRGSelection();
     for(int i = 0; i < RGLen; i++) {
-        includedRGs.at(i) = true;
-        includedRowNum += footer.rowgroupinfos(RGStart + i).numberofrows();
+        includedRGs.at(i) = rgSelection.empty() || rgSelection.at(RGStart + i);
+        if(includedRGs.at(i)) {
+            includedRowNum += footer.rowgroupinfos(RGStart + i).numberofrows();
+        }
     }
     targetRGs.clear();
     targetRGs.resize(RGLen);
@@ -269,8 +272,6 @@ void PixelsRecordReaderImpl::prepareRead() {
     // read row group footers
     rowGroupFooters.clear();
     rowGroupFooters.resize(targetRGNum);
-    std::vector<bool> rowGroupFooterCacheHit;
-    rowGroupFooterCacheHit.resize(targetRGNum);
 
     /**
      * Issue #114:
@@ -282,14 +283,18 @@ void PixelsRecordReaderImpl::prepareRead() {
     RequestBatch requestBatch;
     std::vector<int> fis;
     std::vector<std::string> rgCacheIds;
+    std::string fileId = footerCache != nullptr ? PixelsFooterCache::fileId(physicalReader->getPath()) : "";
     for(int i = 0; i < targetRGNum; i++) {
         int rgId = targetRGs[i];
-        std::string rgCacheId = fileName + "-" + std::to_string(rgId);
+        std::string rgCacheId = fileId + "-" + std::to_string(rgId);
         rgCacheIds.emplace_back(rgCacheId);
-        if(footerCache != nullptr && footerCache->containsRGFooter(rgCacheId)) {
+        std::shared_ptr<pixels::proto::RowGroupFooter> cachedFooter;
+        if(footerCache != nullptr) {
+            cachedFooter = footerCache->findRGFooter(rgCacheId);
+        }
+        if(cachedFooter != nullptr) {
             // cache hit
-            rowGroupFooters.at(i) = footerCache->getRGFooter(rgCacheId);
-            rowGroupFooterCacheHit.at(i) = true;
+            rowGroupFooters.at(i) = cachedFooter;
         } else {
             // cache miss, read from disk and put it into cache
             const pixels::proto::RowGroupInformation& rowGroupInformation = footer.rowgroupinfos(rgId);
@@ -297,21 +302,19 @@ void PixelsRecordReaderImpl::prepareRead() {
             uint64_t footerLength = rowGroupInformation.footerlength();
             fis.push_back(i);
             requestBatch.add(queryId, (int) footerOffset, (int) footerLength);
-            rowGroupFooterCacheHit.at(i) = false;
         }
     }
     Scheduler * scheduler = SchedulerFactory::Instance()->getScheduler();
     auto bbs = scheduler->executeBatch(physicalReader, requestBatch, queryId);
     // TODO: the return value should be unique_ptr?
 
+    // bbs holds the footers of cache misses only, in the order of fis
     for(int i = 0; i < bbs.size(); i++) {
-        if(!rowGroupFooterCacheHit.at(i)) {
-			auto parsed = std::make_shared<pixels::proto::RowGroupFooter>();
-            parsed->ParseFromArray(bbs[i]->getPointer(), (int)bbs[i]->size());
-            rowGroupFooters.at(fis[i]) = parsed;
-			if(footerCache != nullptr) {
-				footerCache->putRGFooter(rgCacheIds[fis[i]], parsed);
-			}
+        auto parsed = std::make_shared<pixels::proto::RowGroupFooter>();
+        parsed->ParseFromArray(bbs[i]->getPointer(), (int)bbs[i]->size());
+        rowGroupFooters.at(fis[i]) = parsed;
+        if(footerCache != nullptr) {
+            footerCache->putRGFooter(rgCacheIds[fis[i]], parsed);
         }
     }
 
@@ -326,20 +329,27 @@ void PixelsRecordReaderImpl::prepareRead() {
 }
 
 void PixelsRecordReaderImpl::asyncReadComplete(int requestSize) {
-    if(ConfigFactory::Instance().boolCheckProperty("localfs.enable.async.io")
-      && has_async_task_num_ >= requestSize) {
-        if(ConfigFactory::Instance().getProperty("localfs.async.lib") == "iouring") {
-            auto localReader = std::static_pointer_cast<PhysicalLocalReader>(physicalReader);
-            localReader->readAsyncComplete(requestSize);
-          has_async_task_num_ -= requestSize;
-        } else if(ConfigFactory::Instance().getProperty("localfs.async.lib") == "aio") {
-            throw InvalidArgumentException("PhysicalLocalReader::readAsync: We don't support aio for our async read yet.");
-        }
+    // a scheduler may merge the chunks into fewer reads than requested
+    requestSize = std::min(requestSize, (int)has_async_task_num_);
+    if(LocalFS::isAsyncEnabled() && requestSize > 0) {
+        auto localReader = std::static_pointer_cast<PhysicalLocalReader>(physicalReader);
+        localReader->readAsyncComplete(requestSize);
+        has_async_task_num_ -= requestSize;
     }
 
 }
 
 
+bool PixelsRecordReaderImpl::asyncReadDrain() {
+    has_async_task_num_ = 0;
+    auto localReader = std::dynamic_pointer_cast<PhysicalLocalReader>(physicalReader);
+    return localReader == nullptr || localReader->readAsyncDrain();
+}
+
+bool PixelsRecordReaderImpl::isEverRead() {
+    return everRead;
+}
+
 std::shared_ptr<PixelsBitMask> PixelsRecordReaderImpl::getFilterMask() {
     return filterMask;
 }
@@ -375,19 +385,40 @@ bool PixelsRecordReaderImpl::read() {
 	}
 
 
-    if(!diskChunks.empty()) {
+    if(!diskChunks.empty() && ::LocalFS::getIoMode() == ::LocalFS::MMAP) {
+        // the chunks are views into the mapped file, so no scan buffer is needed
+        RequestBatch requestBatch((int)diskChunks.size());
+        Scheduler * scheduler = SchedulerFactory::Instance()->getScheduler();
+        for(int i = 0; i < diskChunks.size(); i++) {
+            ChunkId chunk = diskChunks.at(i);
+            requestBatch.add(queryId, chunk.offset, (int)chunk.length);
+        }
+        auto byteBuffers = scheduler->executeBatch(physicalReader, requestBatch, queryId);
+        for(int index = 0; index < diskChunks.size(); index++) {
+            chunkBuffers.at(diskChunks.at(index).columnId) = byteBuffers.at(index);
+        }
+    } else if(!diskChunks.empty()) {
         RequestBatch requestBatch((int)diskChunks.size());
         Scheduler * scheduler = SchedulerFactory::Instance()->getScheduler();
 		std::vector<uint32_t> colIds;
 		std::vector<uint64_t> bytes;
         for(int i = 0; i < diskChunks.size(); i++) {
             ChunkId chunk = diskChunks.at(i);
-            requestBatch.add(queryId, chunk.offset, (int)chunk.length, ::BufferPool::GetBufferId(i));
 			colIds.emplace_back(chunk.columnId);
-			bytes.emplace_back(chunk.length);
+			// size the buffer for the largest chunk of the column in this file
+			uint64_t maxLength = chunk.length;
+			for(const auto & rowGroupFooter : rowGroupFooters) {
+				maxLength = std::max(maxLength, (uint64_t)rowGroupFooter->rowgroupindexentry()
+				        .columnchunkindexentries(chunk.columnId).chunklength());
+			}
+			bytes.emplace_back(maxLength);
         }
 		::BufferPool::Initialize(colIds, bytes, fileSchema->getFieldNames());
-        ::DirectUringRandomAccessFile::RegisterBufferFromPool(colIds);
+        ::DirectUringRandomAccessFile::RegisterBufferFromPool();
+        for(int i = 0; i < diskChunks.size(); i++) {
+            ChunkId chunk = diskChunks.at(i);
+            requestBatch.add(queryId, chunk.offset, (int)chunk.length, ::BufferPool::GetBufferId(chunk.columnId));
+        }
 		std::vector<std::shared_ptr<ByteBuffer>> originalByteBuffers;
 		for(int i = 0; i < colIds.size(); i++) {
             auto colId = colIds.at(i);
@@ -396,8 +427,8 @@ bool PixelsRecordReaderImpl::read() {
 
 		auto byteBuffers = scheduler->executeBatch(physicalReader, requestBatch, originalByteBuffers, queryId);
 
-      if(ConfigFactory::Instance().boolCheckProperty("localfs.enable.async.io") && originalByteBuffers.size() > 0) {
-        has_async_task_num_ += diskChunks.size();
+      if(LocalFS::isAsyncEnabled() && originalByteBuffers.size() > 0) {
+        has_async_task_num_ = std::static_pointer_cast<PhysicalLocalReader>(physicalReader)->getAsyncNumRequests();
       }
         for(int index = 0; index < diskChunks.size(); index++) {
             ChunkId chunk = diskChunks.at(index);
@@ -0,0 +1,49 @@
+//
+// Created by pixels on 10/19/26.
+//
+
+#include "stats/BooleanStatsRecorder.h"
+
+BooleanStatsRecorder::BooleanStatsRecorder() : trueCount(0) {}
+
+BooleanStatsRecorder::BooleanStatsRecorder(const pixels::proto::ColumnStatistic& statistic)
+        : StatsRecorder(statistic), trueCount(0) {
+    if (statistic.has_bucketstatistics() && statistic.bucketstatistics().count_size() > 0) {
+        trueCount = statistic.bucketstatistics().count(0);
+    }
+}
+
+void BooleanStatsRecorder::updateBoolean(bool value, int repetitions) {
+    if (value) {
+        trueCount += repetitions;
+    }
+    numberOfValues += repetitions;
+}
+
+void BooleanStatsRecorder::updateBoolean(const uint8_t* values, int length) {
+    long count = 0;
+    for (int i = 0; i < length; i++) {
+        count += values[i];
+    }
+    trueCount += count;
+    numberOfValues += length;
+}
+
+void BooleanStatsRecorder::merge(const StatsRecorder& stats) {
+    const auto* other = dynamic_cast<const BooleanStatsRecorder*>(&stats);
+    if (other != nullptr) {
+        trueCount += other->trueCount;
+    }
+    StatsRecorder::merge(stats);
+}
+
+void BooleanStatsRecorder::reset() {
+    StatsRecorder::reset();
+    trueCount = 0;
+}
+
+pixels::proto::ColumnStatistic BooleanStatsRecorder::serialize() const {
+    pixels::proto::ColumnStatistic statistic = StatsRecorder::serialize();
+    statistic.mutable_bucketstatistics()->add_count(trueCount);
+    return statistic;
+}
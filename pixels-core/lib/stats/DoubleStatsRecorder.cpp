@@ -0,0 +1,100 @@
+//
+// Created by pixels on 10/19/26.
+//
+
+#include "stats/DoubleStatsRecorder.h"
+#include <algorithm>
+
+DoubleStatsRecorder::DoubleStatsRecorder() : minimum(0), maximum(0), sum(0), hasMinimum(false) {}
+
+DoubleStatsRecorder::DoubleStatsRecorder(const pixels::proto::ColumnStatistic& statistic)
+        : StatsRecorder(statistic), minimum(0), maximum(0), sum(0), hasMinimum(false) {
+    if (statistic.has_doublestatistics()) {
+        const auto& doubleStat = statistic.doublestatistics();
+        if (doubleStat.has_minimum() && doubleStat.has_maximum()) {
+            minimum = doubleStat.minimum();
+            maximum = doubleStat.maximum();
+            hasMinimum = true;
+        }
+        sum = doubleStat.sum();
+    }
+}
+
+void DoubleStatsRecorder::updateFloat(float value) {
+    updateDouble(value);
+}
+
+void DoubleStatsRecorder::updateDouble(double value) {
+    if (!hasMinimum) {
+        hasMinimum = true;
+        minimum = value;
+        maximum = value;
+    } else if (value < minimum) {
+        minimum = value;
+    } else if (value > maximum) {
+        maximum = value;
+    }
+    sum += value;
+    numberOfValues++;
+}
+
+void DoubleStatsRecorder::updateDouble(const double* values, int length) {
+    if (length <= 0) {
+        return;
+    }
+    double min = values[0];
+    double max = values[0];
+    double pixelSum = 0;
+    for (int i = 0; i < length; i++) {
+        min = values[i] < min ? values[i] : min;
+        max = values[i] > max ? values[i] : max;
+        pixelSum += values[i];
+    }
+    if (!hasMinimum) {
+        hasMinimum = true;
+        minimum = min;
+        maximum = max;
+    } else {
+        minimum = std::min(minimum, min);
+        maximum = std::max(maximum, max);
+    }
+    sum += pixelSum;
+    numberOfValues += length;
+}
+
+void DoubleStatsRecorder::merge(const StatsRecorder& stats) {
+    const auto* other = dynamic_cast<const DoubleStatsRecorder*>(&stats);
+    if (other != nullptr) {
+        if (other->hasMinimum) {
+            if (!hasMinimum) {
+                hasMinimum = true;
+                minimum = other->minimum;
+                maximum = other->maximum;
+            } else {
+                minimum = std::min(minimum, other->minimum);
+                maximum = std::max(maximum, other->maximum);
+            }
+        }
+        sum += other->sum;
+    }
+    StatsRecorder::merge(stats);
+}
+
+void DoubleStatsRecorder::reset() {
+    StatsRecorder::reset();
+    minimum = 0;
+    maximum = 0;
+    sum = 0;
+    hasMinimum = false;
+}
+
+pixels::proto::ColumnStatistic DoubleStatsRecorder::serialize() const {
+    pixels::proto::ColumnStatistic statistic = StatsRecorder::serialize();
+    auto* doubleStat = statistic.mutable_doublestatistics();
+    if (hasMinimum) {
+        doubleStat->set_minimum(minimum);
+        doubleStat->set_maximum(maximum);
+    }
+    doubleStat->set_sum(sum);
+    return statistic;
+}
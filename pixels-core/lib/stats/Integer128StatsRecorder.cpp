@@ -0,0 +1,71 @@
+//
+// Created by pixels on 10/19/26.
+//
+
+#include "stats/Integer128StatsRecorder.h"
+
+static __int128 toInteger128(uint64_t high, uint64_t low) {
+    return (__int128) (((unsigned __int128) high << 64) | low);
+}
+
+Integer128StatsRecorder::Integer128StatsRecorder() : minimum(0), maximum(0), hasMinimum(false) {}
+
+Integer128StatsRecorder::Integer128StatsRecorder(const pixels::proto::ColumnStatistic& statistic)
+        : StatsRecorder(statistic), minimum(0), maximum(0), hasMinimum(false) {
+    if (statistic.has_int128statistics()) {
+        const auto& int128Stat = statistic.int128statistics();
+        if (int128Stat.has_minimum_high() && int128Stat.has_maximum_high()) {
+            minimum = toInteger128(int128Stat.minimum_high(), int128Stat.minimum_low());
+            maximum = toInteger128(int128Stat.maximum_high(), int128Stat.maximum_low());
+            hasMinimum = true;
+        }
+    }
+}
+
+void Integer128StatsRecorder::updateInteger128(long high, long low, int repetitions) {
+    __int128 value = toInteger128(high, low);
+    if (!hasMinimum) {
+        hasMinimum = true;
+        minimum = value;
+        maximum = value;
+    } else if (value < minimum) {
+        minimum = value;
+    } else if (value > maximum) {
+        maximum = value;
+    }
+    numberOfValues += repetitions;
+}
+
+void Integer128StatsRecorder::merge(const StatsRecorder& stats) {
+    const auto* other = dynamic_cast<const Integer128StatsRecorder*>(&stats);
+    if (other != nullptr && other->hasMinimum) {
+        if (!hasMinimum) {
+            hasMinimum = true;
+            minimum = other->minimum;
+            maximum = other->maximum;
+        } else {
+            minimum = other->minimum < minimum ? other->minimum : minimum;
+            maximum = other->maximum > maximum ? other->maximum : maximum;
+        }
+    }
+    StatsRecorder::merge(stats);
+}
+
+void Integer128StatsRecorder::reset() {
+    StatsRecorder::reset();
+    minimum = 0;
+    maximum = 0;
+    hasMinimum = false;
+}
+
+pixels::proto::ColumnStatistic Integer128StatsRecorder::serialize() const {
+    pixels::proto::ColumnStatistic statistic = StatsRecorder::serialize();
+    auto* int128Stat = statistic.mutable_int128statistics();
+    if (hasMinimum) {
+        int128Stat->set_minimum_high((uint64_t) (minimum >> 64));
+        int128Stat->set_minimum_low((uint64_t) minimum);
+        int128Stat->set_maximum_high((int64_t) (maximum >> 64));
+        int128Stat->set_maximum_low((int64_t) maximum);
+    }
+    return statistic;
+}
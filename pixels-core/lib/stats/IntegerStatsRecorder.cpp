@@ -0,0 +1,121 @@
+//
+// Created by pixels on 10/19/26.
+//
+
+#include "stats/IntegerStatsRecorder.h"
+#include <climits>
+
+IntegerStatsRecorder::IntegerStatsRecorder() : minimum(LONG_MAX), maximum(LONG_MIN), sum(0), hasMinimum(false), overflow(false) {}
+
+IntegerStatsRecorder::IntegerStatsRecorder(const pixels::proto::ColumnStatistic& statistic)
+        : StatsRecorder(statistic), minimum(LONG_MAX), maximum(LONG_MIN), sum(0), hasMinimum(false), overflow(false) {
+    if (statistic.has_intstatistics()) {
+        const auto& intStat = statistic.intstatistics();
+        if (intStat.has_minimum() && intStat.has_maximum()) {
+            minimum = intStat.minimum();
+            maximum = intStat.maximum();
+            hasMinimum = true;
+        }
+        if (intStat.has_sum()) {
+            sum = intStat.sum();
+        } else {
+            overflow = true;
+        }
+    }
+}
+
+void IntegerStatsRecorder::updateInteger(long value, int repetitions) {
+    if (!hasMinimum) {
+        hasMinimum = true;
+        minimum = value;
+        maximum = value;
+    } else if (value < minimum) {
+        minimum = value;
+    } else if (value > maximum) {
+        maximum = value;
+    }
+    if (!overflow) {
+        long increment;
+        overflow = __builtin_mul_overflow(value, (long) repetitions, &increment) ||
+                   __builtin_add_overflow(sum, increment, &sum);
+    }
+    numberOfValues += repetitions;
+}
+
+void IntegerStatsRecorder::updateInteger(const long* values, int length) {
+    if (length <= 0) {
+        return;
+    }
+    long min = values[0];
+    long max = values[0];
+    for (int i = 1; i < length; i++) {
+        min = values[i] < min ? values[i] : min;
+        max = values[i] > max ? values[i] : max;
+    }
+    long pixelSum = 0;
+    bool pixelOverflow = false;
+    // the sum can not overflow if no value is larger than LONG_MAX / length in magnitude
+    long bound = LONG_MAX / length;
+    if (min >= -bound && max <= bound) {
+        for (int i = 0; i < length; i++) {
+            pixelSum += values[i];
+        }
+    } else {
+        for (int i = 0; i < length; i++) {
+            pixelOverflow |= __builtin_add_overflow(pixelSum, values[i], &pixelSum);
+        }
+    }
+
+    if (!hasMinimum) {
+        hasMinimum = true;
+        minimum = min;
+        maximum = max;
+    } else {
+        minimum = std::min(minimum, min);
+        maximum = std::max(maximum, max);
+    }
+    if (!overflow) {
+        overflow = pixelOverflow || __builtin_add_overflow(sum, pixelSum, &sum);
+    }
+    numberOfValues += length;
+}
+
+void IntegerStatsRecorder::merge(const StatsRecorder& stats) {
+    const auto* other = dynamic_cast<const IntegerStatsRecorder*>(&stats);
+    if (other != nullptr) {
+        if (other->hasMinimum) {
+            if (!hasMinimum) {
+                hasMinimum = true;
+                minimum = other->minimum;
+                maximum = other->maximum;
+            } else {
+                minimum = std::min(minimum, other->minimum);
+                maximum = std::max(maximum, other->maximum);
+            }
+        }
+        overflow = overflow || other->overflow || __builtin_add_overflow(sum, other->sum, &sum);
+    }
+    StatsRecorder::merge(stats);
+}
+
+void IntegerStatsRecorder::reset() {
+    StatsRecorder::reset();
+    minimum = LONG_MAX;
+    maximum = LONG_MIN;
+    sum = 0;
+    hasMinimum = false;
+    overflow = false;
+}
+
+pixels::proto::ColumnStatistic IntegerStatsRecorder::serialize() const {
+    pixels::proto::ColumnStatistic statistic = StatsRecorder::serialize();
+    auto* intStat = statistic.mutable_intstatistics();
+    if (hasMinimum) {
+        intStat->set_minimum(minimum);
+        intStat->set_maximum(maximum);
+    }
+    if (!overflow) {
+        intStat->set_sum(sum);
+    }
+    return statistic;
+}
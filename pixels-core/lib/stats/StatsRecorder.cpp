@@ -23,6 +23,14 @@
 //
 
 #include "stats/StatsRecorder.h"
+#include "stats/BooleanStatsRecorder.h"
+#include "stats/DateStatsRecorder.h"
+#include "stats/DoubleStatsRecorder.h"
+#include "stats/Integer128StatsRecorder.h"
+#include "stats/IntegerStatsRecorder.h"
+#include "stats/StringStatsRecorder.h"
+#include "stats/TimeStatsRecorder.h"
+#include "stats/TimestampStatsRecorder.h"
 #include <stdexcept>
 
 
@@ -89,6 +97,30 @@ void StatsRecorder::updateVector() {
     throw std::logic_error("Can't update vector");
 }
 
+void StatsRecorder::updateInteger(const long*, int) {
+    throw std::logic_error("Can't update integer");
+}
+
+void StatsRecorder::updateDouble(const double*, int) {
+    throw std::logic_error("Can't update double");
+}
+
+void StatsRecorder::updateDate(const int*, int) {
+    throw std::logic_error("Can't update date");
+}
+
+void StatsRecorder::updateTime(const int*, int) {
+    throw std::logic_error("Can't update time");
+}
+
+void StatsRecorder::updateTimestamp(const long*, int) {
+    throw std::logic_error("Can't update timestamp");
+}
+
+void StatsRecorder::updateString(const char*, int, int) {
+    throw std::logic_error("Can't update string");
+}
+
 bool StatsRecorder::isStatsExists() const {
     return (numberOfValues > 0 || hasNull);
 }
@@ -121,11 +153,32 @@ pixels::proto::ColumnStatistic StatsRecorder::serialize() const {
 
 std::unique_ptr<StatsRecorder> StatsRecorder::create(TypeDescription type) {
     switch (type.getCategory()) {
-
         case TypeDescription::BOOLEAN:
-            // return std::make_unique<BooleanStatsRecorder>();
-            break;
-
+            return std::make_unique<BooleanStatsRecorder>();
+        case TypeDescription::BYTE:
+        case TypeDescription::SHORT:
+        case TypeDescription::INT:
+        case TypeDescription::LONG:
+            return std::make_unique<IntegerStatsRecorder>();
+        case TypeDescription::DECIMAL:
+            // short decimals are stored as long, long decimals as two longs
+            if (type.getPrecision() <= TypeDescription::SHORT_DECIMAL_MAX_PRECISION) {
+                return std::make_unique<IntegerStatsRecorder>();
+            }
+            return std::make_unique<Integer128StatsRecorder>();
+        case TypeDescription::FLOAT:
+        case TypeDescription::DOUBLE:
+            return std::make_unique<DoubleStatsRecorder>();
+        case TypeDescription::STRING:
+        case TypeDescription::VARCHAR:
+        case TypeDescription::CHAR:
+            return std::make_unique<StringStatsRecorder>();
+        case TypeDescription::DATE:
+            return std::make_unique<DateStatsRecorder>();
+        case TypeDescription::TIME:
+            return std::make_unique<TimeStatsRecorder>();
+        case TypeDescription::TIMESTAMP:
+            return std::make_unique<TimestampStatsRecorder>();
         default:
             return std::make_unique<StatsRecorder>();
     }
@@ -133,17 +186,41 @@ std::unique_ptr<StatsRecorder> StatsRecorder::create(TypeDescription type) {
 
 
 std::unique_ptr<StatsRecorder> StatsRecorder::create(TypeDescription type, const pixels::proto::ColumnStatistic& statistic) {
-    switch (type.getCategory()) {
-
-        default:
-            return std::make_unique<StatsRecorder>(statistic);
+    if (type.getCategory() == TypeDescription::DECIMAL &&
+        type.getPrecision() > TypeDescription::SHORT_DECIMAL_MAX_PRECISION) {
+        return std::make_unique<Integer128StatsRecorder>(statistic);
     }
+    return create(type.getCategory(), statistic);
 }
 
 
 std::unique_ptr<StatsRecorder> StatsRecorder::create(TypeDescription::Category category, const pixels::proto::ColumnStatistic& statistic) {
     switch (category) {
-
+        case TypeDescription::BOOLEAN:
+            return std::make_unique<BooleanStatsRecorder>(statistic);
+        case TypeDescription::BYTE:
+        case TypeDescription::SHORT:
+        case TypeDescription::INT:
+        case TypeDescription::LONG:
+            return std::make_unique<IntegerStatsRecorder>(statistic);
+        case TypeDescription::DECIMAL:
+            if (statistic.has_int128statistics()) {
+                return std::make_unique<Integer128StatsRecorder>(statistic);
+            }
+            return std::make_unique<IntegerStatsRecorder>(statistic);
+        case TypeDescription::FLOAT:
+        case TypeDescription::DOUBLE:
+            return std::make_unique<DoubleStatsRecorder>(statistic);
+        case TypeDescription::STRING:
+        case TypeDescription::VARCHAR:
+        case TypeDescription::CHAR:
+            return std::make_unique<StringStatsRecorder>(statistic);
+        case TypeDescription::DATE:
+            return std::make_unique<DateStatsRecorder>(statistic);
+        case TypeDescription::TIME:
+            return std::make_unique<TimeStatsRecorder>(statistic);
+        case TypeDescription::TIMESTAMP:
+            return std::make_unique<TimestampStatsRecorder>(statistic);
         default:
             return std::make_unique<StatsRecorder>(statistic);
     }
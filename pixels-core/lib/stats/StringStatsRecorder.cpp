@@ -0,0 +1,82 @@
+//
+// Created by pixels on 10/19/26.
+//
+
+#include "stats/StringStatsRecorder.h"
+#include <string_view>
+
+StringStatsRecorder::StringStatsRecorder() : sum(0), hasMinimum(false) {}
+
+StringStatsRecorder::StringStatsRecorder(const pixels::proto::ColumnStatistic& statistic)
+        : StatsRecorder(statistic), sum(0), hasMinimum(false) {
+    if (statistic.has_stringstatistics()) {
+        const auto& stringStat = statistic.stringstatistics();
+        if (stringStat.has_minimum() && stringStat.has_maximum()) {
+            minimum = stringStat.minimum();
+            maximum = stringStat.maximum();
+            hasMinimum = true;
+        }
+        sum = stringStat.sum();
+    }
+}
+
+void StringStatsRecorder::updateString(const std::string& value, int repetitions) {
+    updateString(value.data(), value.size(), repetitions);
+}
+
+void StringStatsRecorder::updateString(const char* value, int length, int repetitions) {
+    std::string_view view(value, length);
+    if (!hasMinimum) {
+        hasMinimum = true;
+        minimum.assign(view);
+        maximum.assign(view);
+    } else if (view < minimum) {
+        minimum.assign(view);
+    } else if (view > maximum) {
+        maximum.assign(view);
+    }
+    sum += (long) length * repetitions;
+    numberOfValues += repetitions;
+}
+
+void StringStatsRecorder::merge(const StatsRecorder& stats) {
+    const auto* other = dynamic_cast<const StringStatsRecorder*>(&stats);
+    if (other != nullptr) {
+        if (other->hasMinimum) {
+            if (!hasMinimum) {
+                hasMinimum = true;
+                minimum = other->minimum;
+                maximum = other->maximum;
+            } else {
+                if (other->minimum < minimum) {
+                    minimum = other->minimum;
+                }
+                if (other->maximum > maximum) {
+                    maximum = other->maximum;
+                }
+            }
+        }
+        sum += other->sum;
+    }
+    StatsRecorder::merge(stats);
+}
+
+void StringStatsRecorder::reset() {
+    StatsRecorder::reset();
+    // clear() keeps the capacity of the strings
+    minimum.clear();
+    maximum.clear();
+    sum = 0;
+    hasMinimum = false;
+}
+
+pixels::proto::ColumnStatistic StringStatsRecorder::serialize() const {
+    pixels::proto::ColumnStatistic statistic = StatsRecorder::serialize();
+    auto* stringStat = statistic.mutable_stringstatistics();
+    if (hasMinimum) {
+        stringStat->set_minimum(minimum);
+        stringStat->set_maximum(maximum);
+    }
+    stringStat->set_sum(sum);
+    return statistic;
+}
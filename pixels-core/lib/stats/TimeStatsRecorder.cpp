@@ -0,0 +1,86 @@
+//
+// Created by pixels on 10/19/26.
+//
+
+#include "stats/TimeStatsRecorder.h"
+#include <algorithm>
+
+TimeStatsRecorder::TimeStatsRecorder() : minimum(0), maximum(0), hasMinimum(false) {}
+
+TimeStatsRecorder::TimeStatsRecorder(const pixels::proto::ColumnStatistic& statistic)
+        : StatsRecorder(statistic), minimum(0), maximum(0), hasMinimum(false) {
+    if (statistic.has_timestatistics()) {
+        const auto& stat = statistic.timestatistics();
+        if (stat.has_minimum() && stat.has_maximum()) {
+            minimum = stat.minimum();
+            maximum = stat.maximum();
+            hasMinimum = true;
+        }
+    }
+}
+
+void TimeStatsRecorder::updateTime(int value) {
+    if (!hasMinimum) {
+        hasMinimum = true;
+        minimum = value;
+        maximum = value;
+    } else if (value < minimum) {
+        minimum = value;
+    } else if (value > maximum) {
+        maximum = value;
+    }
+    numberOfValues++;
+}
+
+void TimeStatsRecorder::updateTime(const int* values, int length) {
+    if (length <= 0) {
+        return;
+    }
+    int min = values[0];
+    int max = values[0];
+    for (int i = 1; i < length; i++) {
+        min = values[i] < min ? values[i] : min;
+        max = values[i] > max ? values[i] : max;
+    }
+    if (!hasMinimum) {
+        hasMinimum = true;
+        minimum = min;
+        maximum = max;
+    } else {
+        minimum = std::min(minimum, min);
+        maximum = std::max(maximum, max);
+    }
+    numberOfValues += length;
+}
+
+void TimeStatsRecorder::merge(const StatsRecorder& stats) {
+    const auto* other = dynamic_cast<const TimeStatsRecorder*>(&stats);
+    if (other != nullptr && other->hasMinimum) {
+        if (!hasMinimum) {
+            hasMinimum = true;
+            minimum = other->minimum;
+            maximum = other->maximum;
+        } else {
+            minimum = std::min(minimum, other->minimum);
+            maximum = std::max(maximum, other->maximum);
+        }
+    }
+    StatsRecorder::merge(stats);
+}
+
+void TimeStatsRecorder::reset() {
+    StatsRecorder::reset();
+    minimum = 0;
+    maximum = 0;
+    hasMinimum = false;
+}
+
+pixels::proto::ColumnStatistic TimeStatsRecorder::serialize() const {
+    pixels::proto::ColumnStatistic statistic = StatsRecorder::serialize();
+    auto* stat = statistic.mutable_timestatistics();
+    if (hasMinimum) {
+        stat->set_minimum(minimum);
+        stat->set_maximum(maximum);
+    }
+    return statistic;
+}
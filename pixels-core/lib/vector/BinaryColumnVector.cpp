@@ -3,17 +3,17 @@
 //
 
 #include "vector/BinaryColumnVector.h"
+#include "utils/HugePageUtil.h"
 
 BinaryColumnVector::BinaryColumnVector(uint64_t len, bool encoding): ColumnVector(len, encoding) {
-    posix_memalign(reinterpret_cast<void **>(&vector), 32,
-                   len * sizeof(duckdb::string_t));
+    vector = (duckdb::string_t *)HugePageUtil::allocateAligned(32, len * sizeof(duckdb::string_t));
     memoryUsage += (long) sizeof(uint8_t) * len;
 }
 
 void BinaryColumnVector::close() {
 	if(!closed) {
 		ColumnVector::close();
-		free(vector);
+		HugePageUtil::freeAligned(vector, capacity * sizeof(duckdb::string_t));
 		vector = nullptr;
 
 	}
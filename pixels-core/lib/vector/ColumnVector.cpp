@@ -8,6 +8,7 @@ ColumnVector::ColumnVector(uint64_t len, bool encoding) {
     writeIndex = 0;
     readIndex = 0;
     length = len;
+    capacity = len;
 	this->encoding = encoding;
     memoryUsage = len + sizeof(int) * 3 + 4;
 	closed = false;
@@ -3,11 +3,11 @@
 //
 
 #include "vector/DateColumnVector.h"
+#include "utils/HugePageUtil.h"
 
 DateColumnVector::DateColumnVector(uint64_t len, bool encoding): ColumnVector(len, encoding) {
 	if(encoding) {
-        posix_memalign(reinterpret_cast<void **>(&dates), 32,
-                       len * sizeof(int32_t));
+        dates = (int *)HugePageUtil::allocateAligned(32, len * sizeof(int32_t));
 	} else {
 		this->dates = nullptr;
 	}
@@ -17,7 +17,7 @@ DateColumnVector::DateColumnVector(uint64_t len, bool encoding): ColumnVector(le
 void DateColumnVector::close() {
 	if(!closed) {
 		if(encoding && dates != nullptr) {
-			free(dates);
+			HugePageUtil::freeAligned(dates, capacity * sizeof(int32_t));
 		}
 		dates = nullptr;
 		ColumnVector::close();
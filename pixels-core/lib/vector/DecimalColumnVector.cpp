@@ -3,6 +3,7 @@
 //
 
 #include "vector/DecimalColumnVector.h"
+#include "utils/HugePageUtil.h"
 #include "duckdb/common/types/decimal.hpp"
 
 /**
@@ -35,13 +36,11 @@ DecimalColumnVector::DecimalColumnVector(uint64_t len, int precision, int scale,
     using duckdb::Decimal;
     if (precision <= Decimal::MAX_WIDTH_INT16) {
         physical_type_ = PhysicalType::INT16;
-        posix_memalign(reinterpret_cast<void **>(&vector), 32,
-                       len * sizeof(int16_t));
+        vector = (long *)HugePageUtil::allocateAligned(32, len * sizeof(int16_t));
         memoryUsage += (uint64_t)sizeof(int16_t) * len;
     } else if (precision <= Decimal::MAX_WIDTH_INT32) {
         physical_type_ = PhysicalType::INT32;
-        posix_memalign(reinterpret_cast<void **>(&vector), 32,
-                       len * sizeof(int32_t));
+        vector = (long *)HugePageUtil::allocateAligned(32, len * sizeof(int32_t));
         memoryUsage += (uint64_t)sizeof(int32_t) * len;
     } else if (precision <= Decimal::MAX_WIDTH_INT64) {
         physical_type_ = PhysicalType::INT64;
@@ -60,7 +59,8 @@ void DecimalColumnVector::close() {
         ColumnVector::close();
         if (physical_type_ == PhysicalType::INT16 ||
             physical_type_ == PhysicalType::INT32) {
-            free(vector);
+            HugePageUtil::freeAligned(vector, capacity * (physical_type_ == PhysicalType::INT16 ?
+                                                        sizeof(int16_t) : sizeof(int32_t)));
         }
         vector = nullptr;
     }
@@ -3,17 +3,16 @@
 //
 
 #include "vector/LongColumnVector.h"
+#include "utils/HugePageUtil.h"
 #include <algorithm>
 
 LongColumnVector::LongColumnVector(uint64_t len, bool encoding, bool isLong): ColumnVector(len, encoding) {
     if(isLong) {
-        posix_memalign(reinterpret_cast<void **>(&longVector), 32,
-                       len * sizeof(int64_t));
+        longVector = (long *)HugePageUtil::allocateAligned(32, len * sizeof(int64_t));
         intVector = nullptr;
     } else {
         longVector = nullptr;
-        posix_memalign(reinterpret_cast<void **>(&intVector), 32,
-                       len * sizeof(int32_t));
+        intVector = (long *)HugePageUtil::allocateAligned(32, len * sizeof(int32_t));
     }
 
     this->isLong = isLong;
@@ -24,10 +23,10 @@ void LongColumnVector::close() {
 	if(!closed) {
 		ColumnVector::close();
 		if(encoding && longVector != nullptr) {
-			free(longVector);
+			HugePageUtil::freeAligned(longVector, capacity * sizeof(int64_t));
 		}
 		if(encoding && intVector != nullptr) {
-			free(intVector);
+			HugePageUtil::freeAligned(intVector, capacity * sizeof(int32_t));
 		}
 		longVector = nullptr;
 		intVector = nullptr;
@@ -110,22 +109,22 @@ void LongColumnVector::ensureSize(uint64_t size, bool preserveData) {
     if (length < size) {
         if (isLong) {
             long *oldVector = longVector;
-            posix_memalign(reinterpret_cast<void **>(&longVector), 32,
-                           size * sizeof(int64_t));
+            longVector = (long *)HugePageUtil::allocateAligned(32, size * sizeof(int64_t));
             if (preserveData) {
                 std::copy(oldVector, oldVector + length, longVector);
             }
-            delete[] oldVector;
+            HugePageUtil::freeAligned(oldVector, capacity * sizeof(int64_t));
+            capacity = size;
             memoryUsage += (long) sizeof(long) * (size - length);
             resize(size);
         } else {
             long *oldVector = intVector;
-            posix_memalign(reinterpret_cast<void **>(&intVector), 32,
-                           size * sizeof(int32_t));
+            intVector = (long *)HugePageUtil::allocateAligned(32, size * sizeof(int32_t));
             if (preserveData) {
                 std::copy(oldVector, oldVector + length, intVector);
             }
-            delete[] oldVector;
+            HugePageUtil::freeAligned(oldVector, capacity * sizeof(int32_t));
+            capacity = size;
             memoryUsage += (long) sizeof(int) * (size - length);
             resize(size);
         }
@@ -3,6 +3,7 @@
 //
 
 #include "vector/TimestampColumnVector.h"
+#include "utils/HugePageUtil.h"
 
 TimestampColumnVector::TimestampColumnVector(int precision, bool encoding): ColumnVector(VectorizedRowBatch::DEFAULT_SIZE, encoding) {
     TimestampColumnVector(VectorizedRowBatch::DEFAULT_SIZE, precision, encoding);
@@ -11,8 +12,7 @@ TimestampColumnVector::TimestampColumnVector(int precision, bool encoding): Colu
 TimestampColumnVector::TimestampColumnVector(uint64_t len, int precision, bool encoding): ColumnVector(len, encoding) {
     this->precision = precision;
     if(encoding) {
-        posix_memalign(reinterpret_cast<void **>(&this->times), 64,
-                       len * sizeof(long));
+        this->times = (long *)HugePageUtil::allocateAligned(64, len * sizeof(long));
     } else {
         this->times = nullptr;
     }
@@ -23,7 +23,7 @@ void TimestampColumnVector::close() {
     if(!closed) {
         ColumnVector::close();
         if(encoding && this->times != nullptr) {
-            free(this->times);
+            HugePageUtil::freeAligned(this->times, capacity * sizeof(long));
         }
         this->times = nullptr;
     }
@@ -24,6 +24,7 @@
 #include <utils/ConfigFactory.h>
 #include "utils/BitUtils.h"
 #include "writer/ColumnWriter.h"
+#include <limits>
 
 const int ColumnWriter::ISNULL_ALIGNMENT = std::stoi(ConfigFactory::Instance().getProperty("isnull.bitmap.alignment"));
 const std::vector<uint8_t> ColumnWriter::ISNULL_PADDING_BUFFER(ColumnWriter::ISNULL_ALIGNMENT, 0);
@@ -36,10 +37,23 @@ std::vector<uint8_t> ColumnWriter::getColumnChunkContent() const {
     return std::vector<uint8_t>(begin, end);
 }
 
+const uint8_t *ColumnWriter::getColumnChunkPointer() const {
+    return outputStream->getPointer() + outputStream->getReadPos();
+}
+
 int ColumnWriter::getColumnChunkSize() const {
     return static_cast<int>(outputStream->getWritePos() - outputStream->getReadPos());
 }
 
+int ColumnWriter::getEstimatedChunkSize() const {
+    long encoded = outputStream->getWritePos() - outputStream->getReadPos();
+    // before the first pixel is encoded, assume the plain size of the widest values
+    long pending = encodedValueNum > 0 ? curPixelVectorIndex * encoded / encodedValueNum
+                                       : curPixelVectorIndex * (long) sizeof(long);
+    long isNullBytes = isNullStream->getWritePos() + (curPixelIsNullIndex + 7) / 8;
+    return static_cast<int>(std::min<long>(encoded + pending + isNullBytes, std::numeric_limits<int>::max()));
+}
+
 pixels::proto::ColumnChunkIndex ColumnWriter::getColumnChunkIndex() {
     return *columnChunkIndex;
 //    return columnChunkIndex.get();
@@ -48,6 +62,14 @@ std::shared_ptr<pixels::proto::ColumnChunkIndex> ColumnWriter::getColumnChunkInd
     return columnChunkIndex;
 }
 
+const StatsRecorder& ColumnWriter::getColumnChunkStatRecorder() const {
+    return *columnChunkStatRecorder;
+}
+
+pixels::proto::ColumnStatistic ColumnWriter::getColumnChunkStat() const {
+    return columnChunkStatRecorder->serialize();
+}
+
 pixels::proto::ColumnEncoding ColumnWriter::getColumnChunkEncoding() const {
     pixels::proto::ColumnEncoding encoding;
     encoding.set_kind(pixels::proto::ColumnEncoding::Kind::ColumnEncoding_Kind_NONE);
@@ -73,33 +95,43 @@ void ColumnWriter::newPixel() {
     if (hasNull) {
         auto compacted = BitUtils::bitWiseCompact(isNull, curPixelIsNullIndex, byteOrder);
         isNullStream->putBytes(const_cast<uint8_t*>(compacted.data()), compacted.size());
-        pixelStatRecorder.setHasNull();
+        pixelStatRecorder->setHasNull();
     }
     curPixelPosition = static_cast<int>(outputStream->getWritePos());
+    encodedValueNum += curPixelVectorIndex;
     curPixelEleIndex = 0;
     curPixelVectorIndex = 0;
     curPixelIsNullIndex = 0;
 
-    columnChunkStatRecorder.merge(pixelStatRecorder);
+    columnChunkStatRecorder->merge(*pixelStatRecorder);
 
     pixels::proto::PixelStatistic pixelStat;
-    *pixelStat.mutable_statistic() = pixelStatRecorder.serialize();
+    *pixelStat.mutable_statistic() = pixelStatRecorder->serialize();
     columnChunkIndex->add_pixelpositions(lastPixelPosition);
     auto new_pixelstatistic = columnChunkIndex->add_pixelstatistics();
     *new_pixelstatistic = pixelStat;
 
     lastPixelPosition = curPixelPosition;
-    pixelStatRecorder.reset();
+    pixelStatRecorder->reset();
     hasNull = false;
 }
 
 void ColumnWriter::reset() {
     lastPixelPosition = 0;
     curPixelPosition = 0;
+    curPixelEleIndex = 0;
+    curPixelVectorIndex = 0;
+    curPixelIsNullIndex = 0;
+    encodedValueNum = 0;
+    hasNull = false;
+    // Clear() keeps the allocated pixel positions and statistics for reuse in the next row group
     columnChunkIndex->Clear();
-    columnChunkStat->Clear();
-    pixelStatRecorder.reset();
-    columnChunkStatRecorder.reset();
+    columnChunkIndex->set_littleendian(byteOrder == ByteOrder::PIXELS_LITTLE_ENDIAN);
+    columnChunkIndex->set_nullspadding(nullsPadding);
+    columnChunkIndex->set_isnullalignment(ISNULL_ALIGNMENT);
+    pixelStatRecorder->reset();
+    columnChunkStatRecorder->reset();
+    // the streams keep their capacity
     outputStream->resetPosition();
     isNullStream->resetPosition();
 }
@@ -113,13 +145,21 @@ void ColumnWriter::close() {
 
 ColumnWriter::ColumnWriter(std::shared_ptr<TypeDescription> type,
                                    std::shared_ptr<PixelsWriterOption> writerOption)
+        : ColumnWriter(type, writerOption, false) // default is false
+{
+}
+
+ColumnWriter::ColumnWriter(std::shared_ptr<TypeDescription> type,
+                                   std::shared_ptr<PixelsWriterOption> writerOption, bool nullsPadding)
         : pixelStride(writerOption->getPixelsStride()),
           encodingLevel(writerOption->getEncodingLevel()),
           byteOrder(writerOption->getByteOrder()),
-          nullsPadding(false),// default is false
+          nullsPadding(nullsPadding),
           isNull(pixelStride, false)
 
 {
+    pixelStatRecorder=StatsRecorder::create(*type);
+    columnChunkStatRecorder=StatsRecorder::create(*type);
     outputStream=std::make_shared<ByteBuffer>();
     isNullStream=std::make_shared<ByteBuffer>();
     columnChunkIndex=std::make_shared<pixels::proto::ColumnChunkIndex>();
@@ -24,6 +24,10 @@
 //#include "writer/ColumnWriterBuilder.h"
 #include "writer/ColumnWriterBuilder.h"
 #include "writer/IntegerColumnWriter.h"
+#include "writer/StringColumnWriter.h"
+#include "writer/DateColumnWriter.h"
+#include "writer/DecimalColumnWriter.h"
+#include "writer/TimestampColumnWriter.h"
 
 std::shared_ptr<ColumnWriter> ColumnWriterBuilder::newColumnWriter(std::shared_ptr<TypeDescription> type, std::shared_ptr<PixelsWriterOption> writerOption) {
     switch(type->getCategory()) {
@@ -32,6 +36,16 @@ std::shared_ptr<ColumnWriter> ColumnWriterBuilder::newColumnWriter(std::shared_p
         case TypeDescription::LONG:
 //            return std::dynamic_pointer_cast<ColumnWriter,IntegerColumnWriter>(std::make_shared<IntegerColumnWriter>(type, writerOption));
             return std::make_shared<IntegerColumnWriter>(type, writerOption);
+        case TypeDescription::DECIMAL:
+            if (type->getPrecision() <= TypeDescription::SHORT_DECIMAL_MAX_PRECISION)
+            {
+                return std::make_shared<DecimalColumnWriter>(type, writerOption);
+            }
+            break;
+        case TypeDescription::DATE:
+            return std::make_shared<DateColumnWriter>(type, writerOption);
+        case TypeDescription::TIMESTAMP:
+            return std::make_shared<TimestampColumnWriter>(type, writerOption);
         case TypeDescription::BOOLEAN:
             break;
         case TypeDescription::BYTE:
@@ -41,7 +55,9 @@ std::shared_ptr<ColumnWriter> ColumnWriterBuilder::newColumnWriter(std::shared_p
         case TypeDescription::DOUBLE:
             break;
         case TypeDescription::STRING:
-            break;
+        case TypeDescription::VARCHAR:
+        case TypeDescription::CHAR:
+            return std::make_shared<StringColumnWriter>(type, writerOption);
         case TypeDescription::TIME:
             break;
         case TypeDescription::VARBINARY:
@@ -16,4 +16,116 @@
  * You should have received a copy of the Affero GNU General Public
  * License along with Pixels.  If not, see
  * <https://www.gnu.org/licenses/>.
- */
\ No newline at end of file
+ */
+
+#include "writer/DecimalColumnWriter.h"
+
+DecimalColumnWriter::DecimalColumnWriter(std::shared_ptr<TypeDescription> type, std::shared_ptr<PixelsWriterOption> writerOption) :
+ColumnWriter(type, writerOption, true), curPixelVector(pixelStride)
+{
+}
+
+int DecimalColumnWriter::write(std::shared_ptr<ColumnVector> vector, int size)
+{
+    auto columnVector = std::static_pointer_cast<DecimalColumnVector>(vector);
+    if (!columnVector)
+    {
+        throw std::invalid_argument("Invalid vector type");
+    }
+    int start = outputStream->getWritePos();
+
+    int curPartLength;         // size of the partition which belongs to current pixel
+    int curPartOffset = 0;     // starting offset of the partition which belongs to current pixel
+    int nextPartLength = size; // size of the partition which belongs to next pixel
+
+    // do the calculation to partition the vector into current pixel and next one
+    // doing this pre-calculation to eliminate branch prediction inside the for loop
+    while ((curPixelIsNullIndex + nextPartLength) >= pixelStride)
+    {
+        curPartLength = pixelStride - curPixelIsNullIndex;
+        writeCurPartDecimal(columnVector, curPartLength, curPartOffset);
+        newPixel();
+        curPartOffset += curPartLength;
+        nextPartLength = size - curPartOffset;
+    }
+
+    curPartLength = nextPartLength;
+    writeCurPartDecimal(columnVector, curPartLength, curPartOffset);
+
+    return outputStream->getWritePos() - start;
+}
+
+void DecimalColumnWriter::writeCurPartDecimal(std::shared_ptr<DecimalColumnVector> columnVector, int curPartLength, int curPartOffset)
+{
+    // the column vector holds the unscaled values in the physical type of its precision
+    for (int i = 0; i < curPartLength; i++)
+    {
+        int index = i + curPartOffset;
+        curPixelEleIndex++;
+        if (columnVector->isNull[index])
+        {
+            hasNull = true;
+            // padding 0 for nulls
+            curPixelVector[curPixelVectorIndex++] = 0L;
+        }
+        else if (columnVector->physical_type_ == PhysicalType::INT16)
+        {
+            curPixelVector[curPixelVectorIndex++] = reinterpret_cast<int16_t*>(columnVector->vector)[index];
+        }
+        else if (columnVector->physical_type_ == PhysicalType::INT32)
+        {
+            curPixelVector[curPixelVectorIndex++] = reinterpret_cast<int32_t*>(columnVector->vector)[index];
+        }
+        else
+        {
+            curPixelVector[curPixelVectorIndex++] = columnVector->vector[index];
+        }
+    }
+    std::copy(columnVector->isNull + curPartOffset, columnVector->isNull + curPartOffset + curPartLength, isNull.begin() + curPixelIsNullIndex);
+    curPixelIsNullIndex += curPartLength;
+}
+
+bool DecimalColumnWriter::decideNullsPadding(std::shared_ptr<PixelsWriterOption> writerOption)
+{
+    // DecimalColumnReader reads a value for each row
+    return true;
+}
+
+void DecimalColumnWriter::newPixel()
+{
+    // update the statistics with the values of the pixel, the padded nulls are only counted
+    if (hasNull)
+    {
+        for (int i = 0; i < curPixelVectorIndex; i++)
+        {
+            if (isNull[i])
+            {
+                pixelStatRecorder->increment();
+            }
+            else
+            {
+                pixelStatRecorder->updateInteger(curPixelVector[i], 1);
+            }
+        }
+    }
+    else
+    {
+        pixelStatRecorder->updateInteger(curPixelVector.data(), curPixelVectorIndex);
+    }
+
+    if (byteOrder == ByteOrder::PIXELS_LITTLE_ENDIAN)
+    {
+        // the supported hosts are little-endian, so the pixel is copied as it is
+        outputStream->putBytes(reinterpret_cast<uint8_t*>(curPixelVector.data()), curPixelVectorIndex * sizeof(long));
+    }
+    else
+    {
+        EncodingUtils encodingUtils;
+        for (int i = 0; i < curPixelVectorIndex; i++)
+        {
+            encodingUtils.writeLongBE(outputStream, curPixelVector[i]);
+        }
+    }
+
+    ColumnWriter::newPixel();
+}
@@ -20,6 +20,7 @@
 
 #include "writer/IntegerColumnWriter.h"
 #include "utils/BitUtils.h"
+#include <cstring>
 
 IntegerColumnWriter::IntegerColumnWriter(std::shared_ptr<TypeDescription> type, std::shared_ptr<PixelsWriterOption> writerOption) :
 ColumnWriter(type, writerOption), curPixelVector(pixelStride)
@@ -34,12 +35,12 @@ ColumnWriter(type, writerOption), curPixelVector(pixelStride)
 
 int IntegerColumnWriter::write(std::shared_ptr<ColumnVector> vector, int size)
 {
-    std::cout<<"In IntegerColumnWriter"<<std::endl;
     auto columnVector = std::static_pointer_cast<LongColumnVector>(vector);
     if (!columnVector)
     {
         throw std::invalid_argument("Invalid vector type");
     }
+    int start = outputStream->getWritePos();
     long* values;
     if(columnVector->isLongVector()){
       values=columnVector->longVector;
@@ -66,7 +67,7 @@ int IntegerColumnWriter::write(std::shared_ptr<ColumnVector> vector, int size)
     curPartLength = nextPartLength;
     writeCurPartLong(columnVector, values, curPartLength, curPartOffset);
 
-    return outputStream->getWritePos();
+    return outputStream->getWritePos() - start;
 }
 
 void IntegerColumnWriter::close()
@@ -77,6 +78,15 @@ void IntegerColumnWriter::close()
     }
     ColumnWriter::close();
 }
+
+void IntegerColumnWriter::reset()
+{
+    if (runlengthEncoding && encoder)
+    {
+        encoder->clear();
+    }
+    ColumnWriter::reset();
+}
 void IntegerColumnWriter::writeCurPartLong(std::shared_ptr<ColumnVector> columnVector, long *values, int curPartLength, int curPartOffset)
 {
     for (int i = 0; i < curPartLength; i++)
@@ -111,55 +121,72 @@ bool IntegerColumnWriter::decideNullsPadding(std::shared_ptr<PixelsWriterOption>
 
 void IntegerColumnWriter::newPixel()
 {
+    // update the statistics with the values of the pixel, the nulls are only counted
+    if (nullsPadding && hasNull)
+    {
+        for (int i = 0; i < curPixelVectorIndex; i++)
+        {
+            if (isNull[i])
+            {
+                pixelStatRecorder->increment();
+            }
+            else
+            {
+                pixelStatRecorder->updateInteger(curPixelVector[i], 1);
+            }
+        }
+    }
+    else
+    {
+        pixelStatRecorder->increment(curPixelEleIndex - curPixelVectorIndex);
+        pixelStatRecorder->updateInteger(curPixelVector.data(), curPixelVectorIndex);
+    }
+
     // write out current pixel vector
     if (runlengthEncoding)
     {
-        std::vector<byte> buffer(curPixelVectorIndex * sizeof(int));
-        int resLen;
-        encoder->encode(curPixelVector.data(), buffer.data(), curPixelVectorIndex, resLen);
-        outputStream->putBytes(buffer.data(), resLen);
+        encoder->encode(curPixelVector.data(), curPixelVectorIndex, outputStream);
     }
     else
     {
-        std::shared_ptr<ByteBuffer> curVecPartitionBuffer;
         EncodingUtils encodingUtils;
         if (isLong)
         {
-            curVecPartitionBuffer = std::make_shared<ByteBuffer>(curPixelVectorIndex * sizeof(long));
             if (byteOrder == ByteOrder::PIXELS_LITTLE_ENDIAN)
             {
-                for (int i = 0; i < curPixelVectorIndex; i++)
-                {
-                    encodingUtils.writeLongLE(curVecPartitionBuffer, curPixelVector[i]);
-                }
+                // the supported hosts are little-endian, so the pixel is copied as it is
+                outputStream->putBytes(reinterpret_cast<uint8_t*>(curPixelVector.data()), curPixelVectorIndex * sizeof(long));
             }
             else
             {
                 for (int i = 0; i < curPixelVectorIndex; i++)
                 {
-                    encodingUtils.writeLongBE(curVecPartitionBuffer, curPixelVector[i]);
+                    encodingUtils.writeLongBE(outputStream, curPixelVector[i]);
                 }
             }
         }
         else
         {
-            curVecPartitionBuffer = std::make_shared<ByteBuffer>(curPixelVectorIndex * sizeof(int));
             if (byteOrder == ByteOrder::PIXELS_LITTLE_ENDIAN)
             {
+                // narrow the values straight into the output stream
+                outputStream->reserve(curPixelVectorIndex * sizeof(int));
+                uint8_t* ints = outputStream->getPointer() + outputStream->getWritePos();
                 for (int i = 0; i < curPixelVectorIndex; i++)
                 {
-                    encodingUtils.writeIntLE(curVecPartitionBuffer, (int)curPixelVector[i]);
+                    int value = (int)curPixelVector[i];
+                    std::memcpy(ints + i * sizeof(int), &value, sizeof(int));
                 }
+                outputStream->setWritePos(outputStream->getWritePos() + curPixelVectorIndex * sizeof(int));
             }
             else
             {
                 for (int i = 0; i < curPixelVectorIndex; i++)
                 {
-                    encodingUtils.writeIntBE(curVecPartitionBuffer, (int)curPixelVector[i]);
+                    encodingUtils.writeIntBE(outputStream, (int)curPixelVector[i]);
                 }
             }
         }
-        outputStream->putBytes(curVecPartitionBuffer->getPointer(), curVecPartitionBuffer->getWritePos());
     }
 
     ColumnWriter::newPixel();
@@ -19,26 +19,261 @@
  */
 
 #include "writer/StringColumnWriter.h"
+#include "utils/ConfigFactory.h"
+#include "vector/BinaryColumnVector.h"
+#include <cstring>
+#include <limits>
+#include <string_view>
+
+const double StringColumnWriter::DICTIONARY_THRESHOLD =
+        std::stod(ConfigFactory::Instance().getProperty("pixel.writer.dictionary.threshold"));
 
 StringColumnWriter::StringColumnWriter(std::shared_ptr<TypeDescription> type,std::shared_ptr<PixelsWriterOption> writerOption):
-ColumnWriter(type,writerOption),curPixelVector(pixelStride) {
+ColumnWriter(type,writerOption,true),curPixelVector(pixelStride) {
  encodingUtils= std::make_shared<EncodingUtils>();
  runlengthEncoding = encodingLevel.ge(EncodingLevel::Level::EL2);
+ dictionaryEncoding = encodingLevel.ge(EncodingLevel::Level::EL1);
+ useDictionary = dictionaryEncoding;
  if (runlengthEncoding)
  {
-  encoder = std::make_unique<RunLenIntEncoder>();
+  // StringColumnReader decodes the codes and the starts as unsigned ints
+  encoder = std::make_unique<RunLenIntEncoder>(false, true);
  }
  startsArray=std::make_shared<DynamicIntArray>();
+ dictSlots.assign(INITIAL_DICTIONARY_SLOTS, -1);
+ dictStarts.push_back(0);
+}
+
+int StringColumnWriter::write(std::shared_ptr<ColumnVector> vector,int size) {
+ auto columnVector = std::static_pointer_cast<BinaryColumnVector>(vector);
+ if (!columnVector)
+ {
+  throw std::invalid_argument("Invalid vector type");
+ }
+ int start = outputStream->getWritePos();
+ duckdb::string_t* values = columnVector->vector;
+
+ int curPartLength;         // size of the partition which belongs to current pixel
+ int curPartOffset = 0;     // starting offset of the partition which belongs to current pixel
+ int nextPartLength = size; // size of the partition which belongs to next pixel
+
+ // the encoding may fall back to plain at the end of the first pixel, so it is checked for each partition
+ while ((curPixelIsNullIndex + nextPartLength) >= pixelStride)
+ {
+  curPartLength = pixelStride - curPixelIsNullIndex;
+  if (useDictionary)
+  {
+   writeCurPartWithDict(values, columnVector->isNull, curPartLength, curPartOffset);
+  }
+  else
+  {
+   writeCurPartWithoutDict(values, columnVector->isNull, curPartLength, curPartOffset);
+  }
+  newPixel();
+  curPartOffset += curPartLength;
+  nextPartLength = size - curPartOffset;
+ }
+
+ curPartLength = nextPartLength;
+ if (useDictionary)
+ {
+  writeCurPartWithDict(values, columnVector->isNull, curPartLength, curPartOffset);
+ }
+ else
+ {
+  writeCurPartWithoutDict(values, columnVector->isNull, curPartLength, curPartOffset);
+ }
+
+ return outputStream->getWritePos() - start;
+}
+
+void StringColumnWriter::writeCurPartWithDict(duckdb::string_t* values,uint8_t* valueIsNull,int curPartLength,int curPartOffset) {
+ for (int i = 0; i < curPartLength; i++)
+ {
+  curPixelEleIndex++;
+  if (valueIsNull[i + curPartOffset])
+  {
+   hasNull = true;
+   pixelStatRecorder->increment();
+   // padding 0 for nulls
+   curPixelVector[curPixelVectorIndex++] = 0L;
+  }
+  else
+  {
+   const duckdb::string_t& value = values[i + curPartOffset];
+   int length = static_cast<int>(value.GetSize());
+   curPixelVector[curPixelVectorIndex++] = addToDictionary(value.GetData(), length);
+   pixelStatRecorder->updateString(value.GetData(), length, 1);
+  }
+ }
+ std::copy(valueIsNull + curPartOffset, valueIsNull + curPartOffset + curPartLength, isNull.begin() + curPixelIsNullIndex);
+ curPixelIsNullIndex += curPartLength;
+}
+
+void StringColumnWriter::writeCurPartWithoutDict(duckdb::string_t* values,uint8_t* valueIsNull,int curPartLength,int curPartOffset) {
+ for (int i = 0; i < curPartLength; i++)
+ {
+  curPixelEleIndex++;
+  // the nulls also have their starts, so their lengths are 0
+  startsArray->add(startOffset);
+  if (valueIsNull[i + curPartOffset])
+  {
+   hasNull = true;
+   pixelStatRecorder->increment();
+  }
+  else
+  {
+   const duckdb::string_t& value = values[i + curPartOffset];
+   int length = static_cast<int>(value.GetSize());
+   outputStream->putBytes(reinterpret_cast<uint8_t*>(const_cast<char*>(value.GetData())), length);
+   startOffset += length;
+   pixelStatRecorder->updateString(value.GetData(), length, 1);
+  }
+ }
+ std::copy(valueIsNull + curPartOffset, valueIsNull + curPartOffset + curPartLength, isNull.begin() + curPixelIsNullIndex);
+ curPixelIsNullIndex += curPartLength;
+}
+
+int StringColumnWriter::addToDictionary(const char* value,int length) {
+ size_t hash = std::hash<std::string_view>{}(std::string_view(value, length));
+ size_t mask = dictSlots.size() - 1;
+ for (size_t slot = hash & mask; ; slot = (slot + 1) & mask)
+ {
+  int code = dictSlots[slot];
+  if (code < 0)
+  {
+   code = static_cast<int>(dictHashes.size());
+   dictSlots[slot] = code;
+   dictHashes.push_back(hash);
+   dictContent.insert(dictContent.end(), value, value + length);
+   dictStarts.push_back(static_cast<long>(dictContent.size()));
+   // keep the load factor under 1/2, so that the probes stay short
+   if (dictHashes.size() * 2 > dictSlots.size())
+   {
+    growDictionary();
+   }
+   return code;
+  }
+  long keyStart = dictStarts[code];
+  if (dictHashes[code] == hash && dictStarts[code + 1] - keyStart == length &&
+      std::memcmp(dictContent.data() + keyStart, value, length) == 0)
+  {
+   return code;
+  }
+ }
+}
+
+void StringColumnWriter::growDictionary() {
+ dictSlots.assign(dictSlots.size() * 2, -1);
+ size_t mask = dictSlots.size() - 1;
+ for (int code = 0; code < static_cast<int>(dictHashes.size()); code++)
+ {
+  size_t slot = dictHashes[code] & mask;
+  while (dictSlots[slot] >= 0)
+  {
+   slot = (slot + 1) & mask;
+  }
+  dictSlots[slot] = code;
+ }
+}
+
+void StringColumnWriter::clearDictionary() {
+ // the slots and the content keep their capacity for the next column chunk
+ std::fill(dictSlots.begin(), dictSlots.end(), -1);
+ dictHashes.clear();
+ dictStarts.clear();
+ dictStarts.push_back(0);
+ dictContent.clear();
 }
 
+void StringColumnWriter::newPixel() {
+ if (useDictionary)
+ {
+  // the encoding of a column chunk is decided by its first pixel, the readers
+  // can not take an empty dictionary, so the pixel must have non-null values
+  if (encodedValueNum == 0 &&
+      (dictHashes.empty() || dictHashes.size() > DICTIONARY_THRESHOLD * curPixelVectorIndex))
+  {
+   fallBackToPlain();
+  }
+  else
+  {
+   writeInts(curPixelVector.data(), curPixelVectorIndex, runlengthEncoding);
+  }
+ }
+ ColumnWriter::newPixel();
+}
+
+void StringColumnWriter::fallBackToPlain() {
+ for (int i = 0; i < curPixelVectorIndex; i++)
+ {
+  startsArray->add(startOffset);
+  if (!isNull[i])
+  {
+   long code = curPixelVector[i];
+   int length = static_cast<int>(dictStarts[code + 1] - dictStarts[code]);
+   outputStream->putBytes(reinterpret_cast<uint8_t*>(dictContent.data() + dictStarts[code]), length);
+   startOffset += length;
+  }
+ }
+ // the values are written as plain content, no code is pending
+ curPixelVectorIndex = 0;
+ useDictionary = false;
+ clearDictionary();
+}
+
+void StringColumnWriter::writeInts(const long* values,int length,bool useRunLength) {
+ if (useRunLength)
+ {
+  encoder->encode(values, length, outputStream);
+ }
+ else if (byteOrder == ByteOrder::PIXELS_LITTLE_ENDIAN)
+ {
+  for (int i = 0; i < length; i++)
+  {
+   encodingUtils->writeIntLE(outputStream, static_cast<int>(values[i]));
+  }
+ }
+ else
+ {
+  for (int i = 0; i < length; i++)
+  {
+   encodingUtils->writeIntBE(outputStream, static_cast<int>(values[i]));
+  }
+ }
+}
 
 void StringColumnWriter::flush(){
  ColumnWriter::flush();
- flushStarts();
+ if (useDictionary && dictHashes.empty())
+ {
+  // the column chunk is empty
+  useDictionary = false;
+ }
+ if (useDictionary)
+ {
+  flushDictionary();
+ }
+ else
+ {
+  flushStarts();
+ }
+}
+
+void StringColumnWriter::flushDictionary() {
+ int dictContentOffset = outputStream->getWritePos();
+ if (!dictContent.empty())
+ {
+  outputStream->putBytes(reinterpret_cast<uint8_t*>(dictContent.data()), dictContent.size());
+ }
+ int dictStartsOffset = outputStream->getWritePos();
+ writeInts(dictStarts.data(), static_cast<int>(dictStarts.size()), runlengthEncoding);
+ outputStream->putInt(dictContentOffset);
+ outputStream->putInt(dictStartsOffset);
 }
 
 void StringColumnWriter::flushStarts() {
- int startsFieldOffset=outputStream->size();
+ int startsFieldOffset=outputStream->getWritePos();
  startsArray->add(startOffset);
  if(byteOrder==ByteOrder::PIXELS_LITTLE_ENDIAN) {
   for (int i=0;i<startsArray->size();i++) {
@@ -50,8 +285,61 @@ void StringColumnWriter::flushStarts() {
   }
  }
  startsArray->clear();
- std::shared_ptr<ByteBuffer> offsetBuffer=std::make_shared<ByteBuffer>(4);
- offsetBuffer->putInt(startsFieldOffset);
- outputStream->putBytes(offsetBuffer->getPointer(),offsetBuffer->getWritePos());
+ outputStream->putInt(startsFieldOffset);
 }
 
+int StringColumnWriter::getEstimatedChunkSize() const {
+ long size = ColumnWriter::getEstimatedChunkSize();
+ if (useDictionary)
+ {
+  size += dictContent.size() + (dictStarts.size() + 2) * sizeof(int);
+ }
+ else
+ {
+  size += (startsArray->size() + 2) * sizeof(int);
+ }
+ return static_cast<int>(std::min<long>(size, std::numeric_limits<int>::max()));
+}
+
+pixels::proto::ColumnEncoding StringColumnWriter::getColumnChunkEncoding() const {
+ pixels::proto::ColumnEncoding columnEncoding;
+ if (useDictionary)
+ {
+  columnEncoding.set_kind(pixels::proto::ColumnEncoding::Kind::ColumnEncoding_Kind_DICTIONARY);
+  columnEncoding.set_dictionarysize(dictHashes.size());
+  if (runlengthEncoding)
+  {
+   columnEncoding.mutable_cascadeencoding()->set_kind(pixels::proto::ColumnEncoding::Kind::ColumnEncoding_Kind_RUNLENGTH);
+  }
+ }
+ else
+ {
+  columnEncoding.set_kind(pixels::proto::ColumnEncoding::Kind::ColumnEncoding_Kind_NONE);
+ }
+ return columnEncoding;
+}
+
+bool StringColumnWriter::decideNullsPadding(std::shared_ptr<PixelsWriterOption> writerOption) {
+ // the codes and the starts of the nulls are always written
+ return true;
+}
+
+void StringColumnWriter::reset() {
+ if (runlengthEncoding && encoder)
+ {
+  encoder->clear();
+ }
+ ColumnWriter::reset();
+ useDictionary = dictionaryEncoding;
+ clearDictionary();
+ startsArray->clear();
+ startOffset = 0;
+}
+
+void StringColumnWriter::close() {
+ if (runlengthEncoding && encoder)
+ {
+  encoder->clear();
+ }
+ ColumnWriter::close();
+}
@@ -16,4 +16,158 @@
  * You should have received a copy of the Affero GNU General Public
  * License along with Pixels.  If not, see
  * <https://www.gnu.org/licenses/>.
- */
\ No newline at end of file
+ */
+
+#include "writer/TimestampColumnWriter.h"
+#include "vector/TimestampColumnVector.h"
+#include "utils/EncodingUtils.h"
+
+TimestampColumnWriter::TimestampColumnWriter(std::shared_ptr<TypeDescription> type, std::shared_ptr<PixelsWriterOption> writerOption) :
+ColumnWriter(type, writerOption, true), curPixelVector(pixelStride)
+{
+    runlengthEncoding = encodingLevel.ge(EncodingLevel::Level::EL2);
+    if (runlengthEncoding)
+    {
+        encoder = std::make_unique<RunLenIntEncoder>();
+    }
+}
+
+int TimestampColumnWriter::write(std::shared_ptr<ColumnVector> vector, int size)
+{
+    auto columnVector = std::static_pointer_cast<TimestampColumnVector>(vector);
+    if (!columnVector)
+    {
+        throw std::invalid_argument("Invalid vector type");
+    }
+    int start = outputStream->getWritePos();
+    long* values = columnVector->times;
+
+    int curPartLength;         // size of the partition which belongs to current pixel
+    int curPartOffset = 0;     // starting offset of the partition which belongs to current pixel
+    int nextPartLength = size; // size of the partition which belongs to next pixel
+
+    // do the calculation to partition the vector into current pixel and next one
+    // doing this pre-calculation to eliminate branch prediction inside the for loop
+    while ((curPixelIsNullIndex + nextPartLength) >= pixelStride)
+    {
+        curPartLength = pixelStride - curPixelIsNullIndex;
+        writeCurPartTimestamp(columnVector, values, curPartLength, curPartOffset);
+        newPixel();
+        curPartOffset += curPartLength;
+        nextPartLength = size - curPartOffset;
+    }
+
+    curPartLength = nextPartLength;
+    writeCurPartTimestamp(columnVector, values, curPartLength, curPartOffset);
+
+    return outputStream->getWritePos() - start;
+}
+
+void TimestampColumnWriter::close()
+{
+    if (runlengthEncoding && encoder)
+    {
+        encoder->clear();
+    }
+    ColumnWriter::close();
+}
+
+void TimestampColumnWriter::reset()
+{
+    if (runlengthEncoding && encoder)
+    {
+        encoder->clear();
+    }
+    useRunLength = false;
+    ColumnWriter::reset();
+}
+
+void TimestampColumnWriter::writeCurPartTimestamp(std::shared_ptr<ColumnVector> columnVector, long* values, int curPartLength, int curPartOffset)
+{
+    for (int i = 0; i < curPartLength; i++)
+    {
+        curPixelEleIndex++;
+        if (columnVector->isNull[i + curPartOffset])
+        {
+            hasNull = true;
+            // padding 0 for nulls
+            curPixelVector[curPixelVectorIndex++] = 0L;
+        }
+        else
+        {
+            curPixelVector[curPixelVectorIndex++] = values[i + curPartOffset];
+        }
+    }
+    std::copy(columnVector->isNull + curPartOffset, columnVector->isNull + curPartOffset + curPartLength, isNull.begin() + curPixelIsNullIndex);
+    curPixelIsNullIndex += curPartLength;
+}
+
+bool TimestampColumnWriter::decideNullsPadding(std::shared_ptr<PixelsWriterOption> writerOption)
+{
+    // TimestampColumnReader reads a value for each row
+    return true;
+}
+
+void TimestampColumnWriter::newPixel()
+{
+    // update the statistics with the values of the pixel, the padded nulls are only counted
+    if (hasNull)
+    {
+        for (int i = 0; i < curPixelVectorIndex; i++)
+        {
+            if (isNull[i])
+            {
+                pixelStatRecorder->increment();
+            }
+            else
+            {
+                pixelStatRecorder->updateTimestamp(curPixelVector[i]);
+            }
+        }
+    }
+    else
+    {
+        pixelStatRecorder->updateTimestamp(curPixelVector.data(), curPixelVectorIndex);
+    }
+
+    // the first pixel decides the encoding of the column chunk
+    if (runlengthEncoding && encodedValueNum == 0)
+    {
+        useRunLength = isNearlySorted(curPixelVector.data(), curPixelVectorIndex);
+    }
+
+    // write out current pixel vector
+    if (useRunLength)
+    {
+        encoder->encode(curPixelVector.data(), curPixelVectorIndex, outputStream);
+    }
+    else if (byteOrder == ByteOrder::PIXELS_LITTLE_ENDIAN)
+    {
+        // the supported hosts are little-endian, so the pixel is copied as it is
+        outputStream->putBytes(reinterpret_cast<uint8_t*>(curPixelVector.data()), curPixelVectorIndex * sizeof(long));
+    }
+    else
+    {
+        EncodingUtils encodingUtils;
+        for (int i = 0; i < curPixelVectorIndex; i++)
+        {
+            encodingUtils.writeLongBE(outputStream, curPixelVector[i]);
+        }
+    }
+
+    ColumnWriter::newPixel();
+}
+
+pixels::proto::ColumnEncoding TimestampColumnWriter::getColumnChunkEncoding() const
+{
+    pixels::proto::ColumnEncoding columnEncoding;
+    if (useRunLength)
+    {
+        columnEncoding.set_kind(pixels::proto::ColumnEncoding::Kind::ColumnEncoding_Kind_RUNLENGTH);
+    }
+    else
+    {
+        columnEncoding.set_kind(pixels::proto::ColumnEncoding::Kind::ColumnEncoding_Kind_NONE);
+    }
+    return columnEncoding;
+}
@@ -6,12 +6,15 @@
 #include "pixels_extension.hpp"
 #include "PixelsScanFunction.hpp"
 #include "PixelsReadBindData.hpp"
+#include "PixelsAggregatePushdown.hpp"
 #include "duckdb.hpp"
 #include "duckdb/common/exception.hpp"
 #include "duckdb/common/string_util.hpp"
 #include "duckdb/function/scalar_function.hpp"
 #include "duckdb/common/optional_ptr.hpp"
 #include <duckdb/parser/parsed_data/create_scalar_function_info.hpp>
+#include "utils/HugePageUtil.h"
+#include "physical/SchedulerFactory.h"
 
 namespace duckdb {
 
@@ -37,6 +40,53 @@ unique_ptr<TableRef> PixelsScanReplacement(ClientContext &context,ReplacementSca
     return std::move(table_function);
 }
 
+// pixels_huge_pages(): the number of 2MB pages that back the memory of the process
+static void PixelsHugePagesFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	result.SetVectorType(VectorType::CONSTANT_VECTOR);
+	ConstantVector::GetData<int64_t>(result)[0] = (int64_t)::HugePageUtil::getHugePagesInUse();
+}
+
+// pixels_io_metrics(): the admission metrics of the ratelimited read request scheduler, one row
+// per priority class. There are no rows if another scheduler is configured
+struct PixelsIoMetricsState : public GlobalTableFunctionState {
+	bool done = false;
+};
+
+static unique_ptr<FunctionData> PixelsIoMetricsBind(ClientContext &context, TableFunctionBindInput &input,
+                                                    vector<LogicalType> &return_types, vector<string> &names) {
+	names = {"priority", "queue_depth", "in_flight", "admitted_batches", "admitted_bytes", "throttled_seconds"};
+	return_types = {LogicalType::VARCHAR, LogicalType::BIGINT, LogicalType::BIGINT,
+	                LogicalType::UBIGINT, LogicalType::UBIGINT, LogicalType::DOUBLE};
+	return nullptr;
+}
+
+static unique_ptr<GlobalTableFunctionState> PixelsIoMetricsInit(ClientContext &context, TableFunctionInitInput &input) {
+	return make_uniq<PixelsIoMetricsState>();
+}
+
+static void PixelsIoMetricsFunction(ClientContext &context, TableFunctionInput &data_p, DataChunk &output) {
+	auto &state = data_p.global_state->Cast<PixelsIoMetricsState>();
+	if (state.done) {
+		return;
+	}
+	state.done = true;
+	auto scheduler = dynamic_cast<RateLimitedScheduler *>(SchedulerFactory::Instance()->getScheduler());
+	if (scheduler == nullptr) {
+		return;
+	}
+	auto metrics = scheduler->getMetrics();
+	for (idx_t row = 0; row < RateLimitedScheduler::PRIORITY_NUM; row++) {
+		auto priority = (RateLimitedScheduler::Priority)row;
+		output.SetValue(0, row, Value(RateLimitedScheduler::priorityName(priority)));
+		output.SetValue(1, row, Value::BIGINT(metrics.queueDepth[row]));
+		output.SetValue(2, row, Value::BIGINT(metrics.inFlight[row]));
+		output.SetValue(3, row, Value::UBIGINT(metrics.admittedBatches[row]));
+		output.SetValue(4, row, Value::UBIGINT(metrics.admittedBytes[row]));
+		output.SetValue(5, row, Value::DOUBLE(metrics.throttledSeconds[row]));
+	}
+	output.SetCardinality(RateLimitedScheduler::PRIORITY_NUM);
+}
+
 void PixelsExtension::Load(DuckDB &db) {
 	Connection con(*db.instance);
 	con.BeginTransaction();
@@ -49,10 +99,25 @@ void PixelsExtension::Load(DuckDB &db) {
 	cinfo.name = "pixels_scan";
 
 	catalog.CreateTableFunction(context, &cinfo);
+
+	ScalarFunction huge_pages_fun("pixels_huge_pages", {}, LogicalType::BIGINT, PixelsHugePagesFunction);
+	huge_pages_fun.stability = FunctionStability::VOLATILE;
+	CreateScalarFunctionInfo huge_pages_info(huge_pages_fun);
+	catalog.CreateFunction(context, huge_pages_info);
+
+	TableFunction io_metrics_fun("pixels_io_metrics", {}, PixelsIoMetricsFunction, PixelsIoMetricsBind,
+	                             PixelsIoMetricsInit);
+	CreateTableFunctionInfo io_metrics_info(io_metrics_fun);
+	catalog.CreateTableFunction(context, &io_metrics_info);
 	con.Commit();
 
 	auto &config = DBConfig::GetConfig(*db.instance);
 	config.replacement_scans.emplace_back(PixelsScanReplacement);
+	config.optimizer_extensions.push_back(PixelsAggregatePushdown::GetOptimizerExtension());
+	config.AddExtensionOption("pixels_io_priority",
+	                          "I/O priority class of pixels scans under the ratelimited read request scheduler: "
+	                          "interactive, normal or background",
+	                          LogicalType::VARCHAR, Value("normal"));
 }
 
 std::string PixelsExtension::Name() {
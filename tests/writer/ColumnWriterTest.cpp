@@ -0,0 +1,188 @@
+/*
+ * Copyright 2024 PixelsDB.
+ *
+ * This file is part of Pixels.
+ *
+ * Pixels is free software: you can redistribute it and/or modify
+ * it under the terms of the Affero GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Pixels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Affero GNU General Public License for more details.
+ *
+ * You should have received a copy of the Affero GNU General Public
+ * License along with Pixels.  If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+#include "reader/DateColumnReader.h"
+#include "reader/DecimalColumnReader.h"
+#include "reader/TimestampColumnReader.h"
+#include "vector/DateColumnVector.h"
+#include "vector/DecimalColumnVector.h"
+#include "vector/TimestampColumnVector.h"
+#include "writer/DateColumnWriter.h"
+#include "writer/DecimalColumnWriter.h"
+#include "writer/TimestampColumnWriter.h"
+#include "ColumnWriterTestUtil.h"
+
+#include "gtest/gtest.h"
+#include <vector>
+
+static std::shared_ptr<PixelsWriterOption> makeOption(int pixel_stride) {
+    auto option = std::make_shared<PixelsWriterOption>();
+    option->setPixelsStride(pixel_stride);
+    option->setNullsPadding(false);
+    option->setEncodingLevel(EncodingLevel(EncodingLevel::EL2));
+    return option;
+}
+
+static pixels::proto::ColumnEncoding
+checkTimestampRoundTrip(const std::vector<long> &values, const std::vector<bool> &nulls) {
+    int len = values.size();
+    int pixel_stride = 64;
+    int precision = 6;
+    bool encoding = true;
+    auto timestamp_column_vector =
+        std::make_shared<TimestampColumnVector>(len, precision, encoding);
+    for (int i = 0; i < len; ++i) {
+        if (nulls[i]) {
+            timestamp_column_vector->addNull();
+        } else {
+            timestamp_column_vector->set(i, values[i]);
+        }
+    }
+
+    TimestampColumnWriter writer(TypeDescription::createTimestamp(), makeOption(pixel_stride));
+    TimestampColumnReader reader(TypeDescription::createTimestamp());
+    return checkRoundTrip<TimestampColumnVector>(
+        writer, reader, timestamp_column_vector, nulls, pixel_stride,
+        [&](const pixels::proto::ColumnEncoding &chunk_encoding) {
+            // only the run length decoder writes into the memory of the vector
+            bool run_length =
+                chunk_encoding.kind() == pixels::proto::ColumnEncoding_Kind_RUNLENGTH;
+            return std::make_shared<TimestampColumnVector>(len, precision, run_length);
+        },
+        [&](TimestampColumnVector &result, int row, int index) {
+            EXPECT_EQ(result.times[index], values[row]) << "at row " << row;
+        });
+}
+
+static pixels::proto::ColumnEncoding
+checkDateRoundTrip(const std::vector<int> &values, const std::vector<bool> &nulls) {
+    int len = values.size();
+    int pixel_stride = 64;
+    bool encoding = true;
+    auto date_column_vector = std::make_shared<DateColumnVector>(len, encoding);
+    for (int i = 0; i < len; ++i) {
+        if (nulls[i]) {
+            date_column_vector->addNull();
+        } else {
+            date_column_vector->set(i, values[i]);
+        }
+    }
+
+    DateColumnWriter writer(TypeDescription::createDate(), makeOption(pixel_stride));
+    DateColumnReader reader(TypeDescription::createDate());
+    return checkRoundTrip<DateColumnVector>(
+        writer, reader, date_column_vector, nulls, pixel_stride,
+        [&](const pixels::proto::ColumnEncoding &chunk_encoding) {
+            // only the run length decoder writes into the memory of the vector
+            bool run_length =
+                chunk_encoding.kind() == pixels::proto::ColumnEncoding_Kind_RUNLENGTH;
+            return std::make_shared<DateColumnVector>(len, run_length);
+        },
+        [&](DateColumnVector &result, int row, int index) {
+            EXPECT_EQ(result.dates[index], values[row]) << "at row " << row;
+        });
+}
+
+TEST(TimestampWriterTest, WriteSortedTimestampWithNull) {
+    int len = 250;
+    std::vector<long> values(len);
+    std::vector<bool> nulls(len);
+    for (int i = 0; i < len; ++i) {
+        // microseconds since the epoch, with deltas wider than 32 bits
+        values[i] = 1700000000000000L + i * 5000000000L + i % 3;
+        // a few nulls keep the pixels nearly sorted
+        nulls[i] = i % 32 == 5;
+    }
+    auto encoding = checkTimestampRoundTrip(values, nulls);
+    EXPECT_EQ(encoding.kind(), pixels::proto::ColumnEncoding_Kind_RUNLENGTH);
+}
+
+TEST(TimestampWriterTest, WriteUnsortedTimestampWithNull) {
+    int len = 250;
+    std::vector<long> values(len);
+    std::vector<bool> nulls(len);
+    for (int i = 0; i < len; ++i) {
+        values[i] = 1700000000000000L - (i * 7919 % 257) * 1000000000L;
+        nulls[i] = i % 7 == 3;
+    }
+    auto encoding = checkTimestampRoundTrip(values, nulls);
+    EXPECT_EQ(encoding.kind(), pixels::proto::ColumnEncoding_Kind_NONE);
+}
+
+TEST(DateWriterTest, WriteSortedDateWithNull) {
+    int len = 250;
+    std::vector<int> values(len);
+    std::vector<bool> nulls(len);
+    for (int i = 0; i < len; ++i) {
+        values[i] = 19000 + i / 3;
+        nulls[i] = i % 32 == 5;
+    }
+    auto encoding = checkDateRoundTrip(values, nulls);
+    EXPECT_EQ(encoding.kind(), pixels::proto::ColumnEncoding_Kind_RUNLENGTH);
+}
+
+TEST(DateWriterTest, WriteUnsortedDateWithNull) {
+    int len = 250;
+    std::vector<int> values(len);
+    std::vector<bool> nulls(len);
+    for (int i = 0; i < len; ++i) {
+        // days before the epoch are negative
+        values[i] = (i * 37 % 101) * 100 - 5000;
+        nulls[i] = i % 7 == 3;
+    }
+    auto encoding = checkDateRoundTrip(values, nulls);
+    EXPECT_EQ(encoding.kind(), pixels::proto::ColumnEncoding_Kind_NONE);
+}
+
+TEST(DecimalWriterTest, WriteDecimalWithNull) {
+    int len = 250;
+    int pixel_stride = 64;
+    int precision = 15;
+    int scale = 2;
+    bool encoding = true;
+    std::vector<long> values(len);
+    std::vector<bool> nulls(len);
+    auto decimal_column_vector =
+        std::make_shared<DecimalColumnVector>(len, precision, scale, encoding);
+    // the vector of a decimal(15, 2) holds int64 values it doesn't own
+    decimal_column_vector->vector = values.data();
+    for (int i = 0; i < len; ++i) {
+        nulls[i] = i % 7 == 3;
+        if (nulls[i]) {
+            decimal_column_vector->addNull();
+        } else {
+            values[i] = (i % 2 ? -1L : 1L) * (123456789012L + i * 1001L);
+            decimal_column_vector->writeIndex++;
+        }
+    }
+
+    auto type = TypeDescription::createDecimal(precision, scale);
+    DecimalColumnWriter writer(type, makeOption(pixel_stride));
+    DecimalColumnReader reader(type);
+    auto column_chunk_encoding = checkRoundTrip<DecimalColumnVector>(
+        writer, reader, decimal_column_vector, nulls, pixel_stride,
+        [&](const pixels::proto::ColumnEncoding &) {
+            return std::make_shared<DecimalColumnVector>(len, precision, scale, encoding);
+        },
+        [&](DecimalColumnVector &result, int row, int index) {
+            EXPECT_EQ(result.vector[index], values[row]) << "at row " << row;
+        });
+    EXPECT_EQ(column_chunk_encoding.kind(), pixels::proto::ColumnEncoding_Kind_NONE);
+}
@@ -0,0 +1,86 @@
+/*
+ * Copyright 2024 PixelsDB.
+ *
+ * This file is part of Pixels.
+ *
+ * Pixels is free software: you can redistribute it and/or modify
+ * it under the terms of the Affero GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Pixels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Affero GNU General Public License for more details.
+ *
+ * You should have received a copy of the Affero GNU General Public
+ * License along with Pixels.  If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PIXELS_COLUMNWRITERTESTUTIL_H
+#define PIXELS_COLUMNWRITERTESTUTIL_H
+
+#include "reader/ColumnReader.h"
+#include "writer/ColumnWriter.h"
+
+#include "gtest/gtest.h"
+#include <functional>
+#include <memory>
+#include <vector>
+
+/**
+ * Write the column vector, read the column chunk back pixel by pixel and check each row.
+ * The readers of the plain encoding point the result vector at the pixel in the column
+ * chunk, so every pixel is read to the start of the result vector, and the result vector
+ * is created by makeResult(encoding) for the encoding of the column chunk.
+ * @param check is called with the result vector, the row and its index in the result vector
+ * @return the encoding of the written column chunk
+ */
+template <typename Vector>
+pixels::proto::ColumnEncoding
+checkRoundTrip(ColumnWriter &writer, ColumnReader &reader,
+               std::shared_ptr<ColumnVector> input_vector,
+               const std::vector<bool> &nulls, int pixel_stride,
+               const std::function<std::shared_ptr<Vector>(
+                   const pixels::proto::ColumnEncoding &)> &makeResult,
+               const std::function<void(Vector &, int, int)> &check) {
+    int len = nulls.size();
+    auto write_size = writer.write(input_vector, len);
+    EXPECT_GT(write_size, 0);
+    writer.flush();
+    auto content = writer.getColumnChunkContent();
+    EXPECT_GT(content.size(), 0);
+    writer.close();
+
+    /**----------------------
+     **      Write End. Use Reader to check
+     *------------------------**/
+    auto buffer = std::make_shared<ByteBuffer>(content.size());
+    buffer->putBytes(content.data(), content.size());
+    auto column_chunk_encoding = writer.getColumnChunkEncoding();
+    auto result_vector = makeResult(column_chunk_encoding);
+    auto bit_mask = std::make_shared<PixelsBitMask>(len);
+
+    auto num_to_read = len;
+    auto pixel_offset = 0;
+    auto vector_index = 0;
+    while (num_to_read) {
+        auto size = std::min(pixel_stride, num_to_read);
+        reader.read(buffer, column_chunk_encoding, pixel_offset, size,
+                    pixel_stride, vector_index, result_vector,
+                    *writer.getColumnChunkIndexPtr(), bit_mask);
+        for (int i = 0; i < size; i++) {
+            int row = pixel_offset + i;
+            EXPECT_EQ(result_vector->checkValid(i), !nulls[row]) << "at row " << row;
+            if (!nulls[row]) {
+                check(*result_vector, row, i);
+            }
+        }
+        pixel_offset += size;
+        num_to_read -= size;
+    }
+    return column_chunk_encoding;
+}
+
+#endif // PIXELS_COLUMNWRITERTESTUTIL_H
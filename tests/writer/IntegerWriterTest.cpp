@@ -185,6 +185,84 @@ TEST(EncodeTest, DISABLED_EncodeLong) {
     }
 }
 
+TEST(EncodeTest, EncodeLongIntoStream) {
+    constexpr size_t len = 1000;
+    std::array<long, len> data;
+    for (size_t i = 0; i < len; i++) {
+        data[i] = 1700000000000000L + i * 7;
+    }
+    // the stream is smaller than the encoded values, it grows once for the worst case
+    auto output = std::make_shared<ByteBuffer>(16);
+    output->putInt(42);
+    auto encoder = std::make_unique<RunLenIntEncoder>();
+    encoder->encode(data.data(), len, output);
+
+    EXPECT_GT(output->getWritePos(), sizeof(int));
+    EXPECT_LE(output->getWritePos(), sizeof(int) + RunLenIntEncoder::maxEncodedLength(len));
+    EXPECT_EQ(output->getInt(), 42);
+
+    bool is_signed = true;
+    auto decoder = std::make_unique<RunLenIntDecoder>(output, is_signed);
+    for (size_t i = 0; i < len; i++) {
+        EXPECT_EQ(decoder->next(), data[i]);
+    }
+}
+
+TEST(EncodeTest, EncodeWideLongIntoStream) {
+    constexpr size_t len = 1000;
+    std::array<long, len> data;
+    for (size_t i = 0; i < len; i++) {
+        // deltas and bases wider than 32 bits, in runs of both signs
+        data[i] = (i / 100 % 2 ? -1L : 1L) * (5000000000L * (long) (i % 100) + (1L << 40));
+    }
+    auto output = std::make_shared<ByteBuffer>(16);
+    auto encoder = std::make_unique<RunLenIntEncoder>();
+    encoder->encode(data.data(), len, output);
+
+    bool is_signed = true;
+    auto decoder = std::make_unique<RunLenIntDecoder>(output, is_signed);
+    for (size_t i = 0; i < len; i++) {
+        EXPECT_EQ(decoder->next(), data[i]);
+    }
+}
+
+TEST(EncodeTest, EncodeOutliersIntoStream) {
+    constexpr size_t len = 1000;
+    std::array<int, len> data;
+    for (size_t i = 0; i < len; i++) {
+        // few outliers among small values, which would be PATCHED_BASE encoded
+        data[i] = i % 97 == 0 ? INT32_MAX - (int) i : (int) (i * 7 % 13);
+    }
+    auto output = std::make_shared<ByteBuffer>(16);
+    auto encoder = std::make_unique<RunLenIntEncoder>();
+    encoder->encode(data.data(), len, output);
+
+    bool is_signed = true;
+    auto decoder = std::make_unique<RunLenIntDecoder>(output, is_signed);
+    for (size_t i = 0; i < len; i++) {
+        EXPECT_EQ(decoder->next(), data[i]);
+    }
+}
+
+TEST(EncodeTest, EncodeSmallIntIntoStream) {
+    constexpr size_t len = 1000;
+    std::array<int, len> data;
+    for (size_t i = 0; i < len; i++) {
+        data[i] = (int) (i * 7 % 13);
+    }
+    auto output = std::make_shared<ByteBuffer>(16);
+    auto encoder = std::make_unique<RunLenIntEncoder>();
+    encoder->encode(data.data(), len, output);
+
+    // aligned bit packing keeps a byte per value, plus the headers of two runs
+    EXPECT_EQ(output->getWritePos(), len + 2 * 2);
+    bool is_signed = true;
+    auto decoder = std::make_unique<RunLenIntDecoder>(output, is_signed);
+    for (size_t i = 0; i < len; i++) {
+        EXPECT_EQ(decoder->next(), data[i]);
+    }
+}
+
 TEST(IntegerWriterTest, DISABLED_WriteRunLengthEncodeLongWithoutNull) {
     int len = 23;
     int pixel_stride = 5;
@@ -0,0 +1,90 @@
+/*
+ * Copyright 2024 PixelsDB.
+ *
+ * This file is part of Pixels.
+ *
+ * Pixels is free software: you can redistribute it and/or modify
+ * it under the terms of the Affero GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Pixels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Affero GNU General Public License for more details.
+ *
+ * You should have received a copy of the Affero GNU General Public
+ * License along with Pixels.  If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+#include "physical/PhysicalWriterUtil.h"
+#include "physical/storage/PhysicalDirectWriter.h"
+#include "utils/ConfigFactory.h"
+#include "gtest/gtest.h"
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+class PHYSICAL_WRITER_TEST : public ::testing::Test
+{
+protected:
+    void SetUp() override {
+        target_file_path_ = ConfigFactory::Instance().getPixelsSourceDirectory() +
+            "cpp/tests/data/physical_writer.pxl";
+        write_mode_ = ConfigFactory::Instance().getProperty("localfs.write.mode");
+        std::filesystem::remove(target_file_path_);
+    }
+    void TearDown() override {
+        ConfigFactory::Instance().addProperty("localfs.write.mode", write_mode_);
+        std::filesystem::remove(target_file_path_);
+    }
+    std::vector<uint8_t> readBack() {
+        std::ifstream input(target_file_path_, std::ios::binary);
+        return std::vector<uint8_t>(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+    }
+protected:
+    std::string target_file_path_;
+    std::string write_mode_;
+    const int block_size_ = 4096;
+};
+
+TEST_F(PHYSICAL_WRITER_TEST, NEW_FILE_IS_WRITTEN_DIRECTLY)
+{
+    ConfigFactory::Instance().addProperty("localfs.write.mode", "direct");
+    // the writer opens its target as PixelsWriterImpl does, without overwrite
+    auto writer = PhysicalWriterUtil::newPhysicalWriter(target_file_path_, block_size_, false, false);
+    ASSERT_TRUE(std::dynamic_pointer_cast<PhysicalDirectWriter>(writer));
+
+    // several staging buffers and a tail that is not block aligned
+    std::vector<uint8_t> data(2 * writer->getBufferSize() + 12345);
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = (uint8_t) (i * 31 + i / 4096);
+    }
+    EXPECT_EQ(writer->append(data.data(), 0, 100), 0);
+    std::vector<struct iovec> buffers{{data.data() + 100, 5000},
+                                      {data.data() + 5100, (size_t) writer->getBufferSize()}};
+    EXPECT_EQ(writer->append(buffers), 100);
+    size_t written = 5100 + writer->getBufferSize();
+    EXPECT_EQ(writer->append(data.data(), written, data.size() - written), written);
+    writer->close();
+
+    EXPECT_EQ(readBack(), data);
+}
+
+TEST_F(PHYSICAL_WRITER_TEST, EXISTING_FILE_IS_APPENDED)
+{
+    std::vector<uint8_t> data(3000, 7);
+    {
+        std::ofstream output(target_file_path_, std::ios::binary);
+        output.write((const char *) data.data(), 1000);
+    }
+    // O_DIRECT writes files from the start, so an existing file is appended by the buffered writer
+    ConfigFactory::Instance().addProperty("localfs.write.mode", "direct");
+    auto writer = PhysicalWriterUtil::newPhysicalWriter(target_file_path_, block_size_, false, false);
+    EXPECT_FALSE(std::dynamic_pointer_cast<PhysicalDirectWriter>(writer));
+    writer->append(data.data(), 1000, 2000);
+    writer->close();
+
+    EXPECT_EQ(readBack(), data);
+}
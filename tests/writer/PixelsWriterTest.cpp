@@ -26,6 +26,12 @@
 #include "PixelsReaderImpl.h"
 #include "physical/PhysicalReaderUtil.h"
 #include "PixelsReaderBuilder.h"
+#include "writer/ColumnWriterBuilder.h"
+#include "utils/ThreadPool.h"
+#include <filesystem>
+#include <functional>
+#include <future>
+#include <numeric>
 #include "gtest/gtest.h"
 
 class PIXELS_WRITER_TEST : public ::testing::Test
@@ -305,4 +311,177 @@ TEST_F(PIXELS_WRITER_TEST, WRITE_TWO_COLUMN_WITHOUT_RUNLENENCODE)
         std::cerr << "[DEBUG] Time: " << duration.count() << std::endl;
     }
 
-}
\ No newline at end of file
+}
+
+TEST_F(PIXELS_WRITER_TEST, DISABLED_WRITE_THROUGHPUT)
+{
+    // many columns and small batches, where dispatching the columns of each batch dominates
+    const int column_num = 32;
+    const int batch_size = 1024;
+    const int batch_num = 2000;
+    std::string type = "struct<";
+    for (int c = 0; c < column_num; ++c) {
+        type += (c == 0 ? "c" : ",c") + std::to_string(c) + ":bigint";
+    }
+    auto schema = TypeDescription::fromString(type + ">");
+    EXPECT_TRUE(schema);
+    std::vector<bool> encode_vector(column_num, true);
+    auto row_batch = schema->createRowBatch(batch_size, encode_vector);
+    for (int c = 0; c < column_num; ++c) {
+        auto vc = std::dynamic_pointer_cast<LongColumnVector>(row_batch->cols[c]);
+        ASSERT_TRUE(vc);
+        for (int i = 0; i < batch_size; ++i) {
+            vc->add((long) i * (c + 1));
+        }
+    }
+    auto option = std::make_shared<PixelsWriterOption>()->setPixelsStride(pixels_stride_)
+            ->setEncodingLevel(EncodingLevel(EncodingLevel::EL2))->setNullsPadding(true);
+
+    // both sides run the same column writers, cut into row groups of 100 batches, and only
+    // differ in how the columns of a batch are dispatched
+    auto run = [&](const std::string &name,
+                   const std::function<void(std::vector<std::shared_ptr<ColumnWriter>> &)> &dispatch) {
+        std::vector<std::shared_ptr<ColumnWriter>> writers(column_num);
+        auto start_time_ts = std::chrono::high_resolution_clock::now();
+        for (int b = 0; b < batch_num; ++b) {
+            if (b % 100 == 0) {
+                for (int c = 0; c < column_num; ++c) {
+                    writers[c] = ColumnWriterBuilder::newColumnWriter(schema->getChildren()[c], option);
+                }
+            }
+            dispatch(writers);
+        }
+        auto duration = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start_time_ts);
+        std::cerr << "[DEBUG] " << name << " rows/s: " << batch_num * batch_size / duration.count() << std::endl;
+    };
+
+    // the previous dispatch: one std::async per column for every batch
+    run("std::async", [&](std::vector<std::shared_ptr<ColumnWriter>> &writers) {
+        std::vector<std::future<int>> futures;
+        for (int c = 0; c < column_num; ++c) {
+            futures.emplace_back(std::async(std::launch::async, [&, c]() {
+                return writers[c]->write(row_batch->cols[c], batch_size);
+            }));
+        }
+        for (auto &future : futures) {
+            future.get();
+        }
+    });
+
+    // the dispatch of PixelsWriterImpl::writeColumnVectors: the columns are grouped by the bytes of
+    // their last batch and the groups run on a persistent pool, the caller encoding one of them
+    ThreadPool pool(std::stoi(ConfigFactory::Instance().getProperty("pixel.writer.encode.threads")));
+    std::vector<int> costs(column_num, 1);
+    run("encode pool", [&](std::vector<std::shared_ptr<ColumnWriter>> &writers) {
+        int group_num = std::min(column_num, pool.getThreadNum() + 1);
+        std::vector<int> order(column_num);
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&](int a, int b) { return costs[a] > costs[b]; });
+        std::vector<std::vector<int>> groups(group_num);
+        std::vector<int64_t> group_costs(group_num, 0);
+        for (int c : order) {
+            int target = std::min_element(group_costs.begin(), group_costs.end()) - group_costs.begin();
+            groups[target].push_back(c);
+            group_costs[target] += std::max(costs[c], 1);
+        }
+        auto encode_group = [&](const std::vector<int> &group) {
+            for (int c : group) {
+                int before = writers[c]->getEstimatedChunkSize();
+                writers[c]->write(row_batch->cols[c], batch_size);
+                costs[c] = writers[c]->getEstimatedChunkSize() - before;
+            }
+        };
+        std::vector<std::future<void>> futures;
+        for (int g = 1; g < group_num; ++g) {
+            futures.emplace_back(pool.submit([&encode_group, &groups, g]() { encode_group(groups[g]); }));
+        }
+        encode_group(groups[0]);
+        for (auto &future : futures) {
+            future.get();
+        }
+    });
+}
+
+TEST_F(PIXELS_WRITER_TEST, WRITE_STATISTICS)
+{
+    auto schema = TypeDescription::fromString("struct<a:bigint>");
+    EXPECT_TRUE(schema);
+    std::vector<bool> encode_vector(1, true);
+    auto row_batch = schema->createRowBatch(row_group_size_, encode_vector);
+
+    EncodingLevel encoding_level{EncodingLevel::EL2};
+    bool nulls_padding = true;
+    bool partitioned = true;
+    // cut a row group for every row batch
+    int row_group_bytes = 1;
+    int batch_num = 3;
+    // the physical writer appends to an existing file
+    std::string file_path = ConfigFactory::Instance().getPixelsSourceDirectory() +
+        "cpp/tests/data/statistics.pxl";
+    std::filesystem::remove(file_path);
+
+    auto pixels_writer = std::make_unique<PixelsWriterImpl>(schema, pixels_stride_, row_group_bytes, file_path,
+                                                            block_size_, block_padding_, encoding_level, nulls_padding, partitioned, compression_block_size_);
+    auto va = std::dynamic_pointer_cast<LongColumnVector>(row_batch->cols[0]);
+    ASSERT_TRUE(va);
+    for (int b = 0; b < batch_num; ++b)
+    {
+        for (int i = 0; i < row_num; ++i)
+        {
+            // the first row group has a null
+            if (b == 0 && i == 0)
+            {
+                va->addNull();
+            }
+            else
+            {
+                va->add((long) (b * 100 + i));
+            }
+        }
+        row_batch->rowCount = row_num;
+        pixels_writer->addRowBatch(row_batch);
+        row_batch->reset();
+    }
+    pixels_writer->close();
+
+    auto footerCache = std::make_shared<PixelsFooterCache>();
+    auto builder = std::make_shared<PixelsReaderBuilder>();
+    std::shared_ptr<::Storage> storage = StorageFactory::getInstance()->getStorage(::Storage::file);
+    std::shared_ptr<PixelsReader> pixels_reader = builder
+                                 ->setPath(file_path)
+                                 ->setStorage(storage)
+                                 ->setPixelsFooterCache(footerCache)
+                                 ->build();
+
+    // the file statistic merges the column chunks of all the row groups
+    auto column_stats = pixels_reader->getColumnStats();
+    ASSERT_EQ(column_stats.size(), 1);
+    auto &file_stat = column_stats.Get(0);
+    EXPECT_EQ(file_stat.numberofvalues(), batch_num * row_num);
+    EXPECT_TRUE(file_stat.hasnull());
+    EXPECT_EQ(file_stat.intstatistics().minimum(), 1);
+    EXPECT_EQ(file_stat.intstatistics().maximum(), (batch_num - 1) * 100 + row_num - 1);
+    long sum = 0;
+    for (int b = 0; b < batch_num; ++b)
+    {
+        for (int i = (b == 0 ? 1 : 0); i < row_num; ++i)
+        {
+            sum += b * 100 + i;
+        }
+    }
+    EXPECT_EQ(file_stat.intstatistics().sum(), sum);
+
+    auto row_group_stats = pixels_reader->getRowGroupStats();
+    ASSERT_EQ(pixels_reader->getRowGroupNum(), batch_num);
+    ASSERT_EQ(row_group_stats.size(), batch_num);
+    for (int b = 0; b < batch_num; ++b)
+    {
+        ASSERT_EQ(row_group_stats.Get(b).columnchunkstats_size(), 1);
+        auto &chunk_stat = row_group_stats.Get(b).columnchunkstats(0);
+        EXPECT_EQ(chunk_stat.numberofvalues(), row_num);
+        EXPECT_EQ(chunk_stat.hasnull(), b == 0);
+        EXPECT_EQ(chunk_stat.intstatistics().minimum(), b * 100 + (b == 0 ? 1 : 0));
+        EXPECT_EQ(chunk_stat.intstatistics().maximum(), b * 100 + row_num - 1);
+    }
+    std::filesystem::remove(file_path);
+}
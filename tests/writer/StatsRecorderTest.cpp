@@ -0,0 +1,227 @@
+/*
+ * Copyright 2024 PixelsDB.
+ *
+ * This file is part of Pixels.
+ *
+ * Pixels is free software: you can redistribute it and/or modify
+ * it under the terms of the Affero GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Pixels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Affero GNU General Public License for more details.
+ *
+ * You should have received a copy of the Affero GNU General Public
+ * License along with Pixels.  If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+#include "stats/StatsRecorder.h"
+#include "vector/LongColumnVector.h"
+#include "writer/IntegerColumnWriter.h"
+
+#include "gtest/gtest.h"
+#include <array>
+#include <climits>
+
+TEST(StatsRecorderTest, IntegerStatistic) {
+    auto recorder = StatsRecorder::create(*TypeDescription::createLong());
+    std::array<long, 5> values{7, -3, 12, 0, 5};
+    recorder->updateInteger(values.data(), values.size());
+    recorder->updateInteger(-8, 2);
+    recorder->increment();
+
+    auto statistic = recorder->serialize();
+    EXPECT_EQ(statistic.numberofvalues(), 8);
+    ASSERT_TRUE(statistic.has_intstatistics());
+    EXPECT_EQ(statistic.intstatistics().minimum(), -8);
+    EXPECT_EQ(statistic.intstatistics().maximum(), 12);
+    ASSERT_TRUE(statistic.intstatistics().has_sum());
+    EXPECT_EQ(statistic.intstatistics().sum(), 21 - 16);
+}
+
+TEST(StatsRecorderTest, IntegerSumOverflow) {
+    auto recorder = StatsRecorder::create(*TypeDescription::createLong());
+    std::array<long, 3> values{LONG_MAX - 1, 2, -5};
+    recorder->updateInteger(values.data(), values.size());
+
+    // the bounds are still valid without the sum
+    auto statistic = recorder->serialize();
+    EXPECT_EQ(statistic.intstatistics().minimum(), -5);
+    EXPECT_EQ(statistic.intstatistics().maximum(), LONG_MAX - 1);
+    EXPECT_FALSE(statistic.intstatistics().has_sum());
+
+    // a value that would bring the sum back into range does not restore it
+    recorder->updateInteger(-LONG_MAX, 1);
+    EXPECT_FALSE(recorder->serialize().intstatistics().has_sum());
+
+    auto single = StatsRecorder::create(*TypeDescription::createLong());
+    single->updateInteger(LONG_MIN / 2, 3);
+    EXPECT_FALSE(single->serialize().intstatistics().has_sum());
+}
+
+TEST(StatsRecorderTest, IntegerMergeOverflow) {
+    auto left = StatsRecorder::create(*TypeDescription::createLong());
+    auto right = StatsRecorder::create(*TypeDescription::createLong());
+    left->updateInteger(LONG_MAX, 1);
+    right->updateInteger(1, 1);
+    EXPECT_TRUE(left->serialize().intstatistics().has_sum());
+    EXPECT_TRUE(right->serialize().intstatistics().has_sum());
+
+    left->merge(*right);
+    auto statistic = left->serialize();
+    EXPECT_EQ(statistic.numberofvalues(), 2);
+    EXPECT_EQ(statistic.intstatistics().minimum(), 1);
+    EXPECT_EQ(statistic.intstatistics().maximum(), LONG_MAX);
+    EXPECT_FALSE(statistic.intstatistics().has_sum());
+
+    // an overflowed sum stays dropped when it is deserialized and merged again
+    auto restored = StatsRecorder::create(*TypeDescription::createLong(), statistic);
+    restored->merge(*right);
+    EXPECT_FALSE(restored->serialize().intstatistics().has_sum());
+}
+
+TEST(StatsRecorderTest, DoubleStatistic) {
+    auto recorder = StatsRecorder::create(*TypeDescription::createDouble());
+    std::array<double, 4> values{1.5, -2.25, 8.0, 0.75};
+    recorder->updateDouble(values.data(), values.size());
+    recorder->updateDouble(-4.0);
+
+    auto statistic = recorder->serialize();
+    EXPECT_EQ(statistic.numberofvalues(), 5);
+    ASSERT_TRUE(statistic.has_doublestatistics());
+    EXPECT_DOUBLE_EQ(statistic.doublestatistics().minimum(), -4.0);
+    EXPECT_DOUBLE_EQ(statistic.doublestatistics().maximum(), 8.0);
+    EXPECT_DOUBLE_EQ(statistic.doublestatistics().sum(), 4.0);
+}
+
+TEST(StatsRecorderTest, StringStatistic) {
+    auto recorder = StatsRecorder::create(*TypeDescription::createString());
+    std::string values = "pixelsduckdbarrow";
+    recorder->updateString(values.data(), 6, 1);
+    recorder->updateString(values.data() + 6, 6, 2);
+    recorder->updateString(std::string("arrow"), 1);
+
+    auto statistic = recorder->serialize();
+    EXPECT_EQ(statistic.numberofvalues(), 4);
+    ASSERT_TRUE(statistic.has_stringstatistics());
+    EXPECT_EQ(statistic.stringstatistics().minimum(), "arrow");
+    EXPECT_EQ(statistic.stringstatistics().maximum(), "pixels");
+    // the sum of a string column is the total length of its values
+    EXPECT_EQ(statistic.stringstatistics().sum(), 6 + 6 * 2 + 5);
+}
+
+TEST(StatsRecorderTest, DateAndTimestampStatistic) {
+    auto date_recorder = StatsRecorder::create(*TypeDescription::createDate());
+    std::array<int, 3> days{19000, 18500, 20100};
+    date_recorder->updateDate(days.data(), days.size());
+    date_recorder->updateDate(18000);
+    auto date_statistic = date_recorder->serialize();
+    ASSERT_TRUE(date_statistic.has_datestatistics());
+    EXPECT_EQ(date_statistic.datestatistics().minimum(), 18000);
+    EXPECT_EQ(date_statistic.datestatistics().maximum(), 20100);
+
+    auto timestamp_recorder =
+        StatsRecorder::create(*TypeDescription::createTimestamp());
+    std::array<long, 3> micros{1700000000000000L, -1000L, 1800000000000000L};
+    timestamp_recorder->updateTimestamp(micros.data(), micros.size());
+    auto timestamp_statistic = timestamp_recorder->serialize();
+    ASSERT_TRUE(timestamp_statistic.has_timestampstatistics());
+    EXPECT_EQ(timestamp_statistic.timestampstatistics().minimum(), -1000L);
+    EXPECT_EQ(timestamp_statistic.timestampstatistics().maximum(),
+              1800000000000000L);
+}
+
+TEST(StatsRecorderTest, MergeAndReset) {
+    auto recorder = StatsRecorder::create(*TypeDescription::createString());
+    auto pixel = StatsRecorder::create(*TypeDescription::createString());
+    pixel->updateString(std::string("b"), 1);
+    pixel->setHasNull();
+    pixel->increment();
+    recorder->merge(*pixel);
+    pixel->reset();
+    pixel->updateString(std::string("a"), 1);
+    recorder->merge(*pixel);
+
+    auto statistic = recorder->serialize();
+    EXPECT_EQ(statistic.numberofvalues(), 3);
+    EXPECT_TRUE(statistic.hasnull());
+    EXPECT_EQ(statistic.stringstatistics().minimum(), "a");
+    EXPECT_EQ(statistic.stringstatistics().maximum(), "b");
+
+    // a reset recorder does not keep any bound of the merged ones
+    recorder->reset();
+    pixel->reset();
+    pixel->updateString(std::string("c"), 1);
+    recorder->merge(*pixel);
+    statistic = recorder->serialize();
+    EXPECT_EQ(statistic.numberofvalues(), 1);
+    EXPECT_FALSE(statistic.hasnull());
+    EXPECT_EQ(statistic.stringstatistics().minimum(), "c");
+    EXPECT_EQ(statistic.stringstatistics().maximum(), "c");
+}
+
+TEST(StatsRecorderTest, ResetColumnWriter) {
+    int len = 40;
+    int pixel_stride = 16;
+    bool is_long = true;
+    bool encoding = true;
+    auto option = std::make_shared<PixelsWriterOption>();
+    option->setPixelsStride(pixel_stride);
+    option->setNullsPadding(true);
+    option->setEncodingLevel(EncodingLevel(EncodingLevel::EL2));
+    auto long_column_writer = std::make_unique<IntegerColumnWriter>(
+        TypeDescription::createLong(), option);
+
+    // the first row group
+    auto long_column_vector =
+        std::make_shared<LongColumnVector>(len, encoding, is_long);
+    for (int i = 0; i < len; ++i) {
+        long_column_vector->add(i);
+    }
+    long_column_writer->write(long_column_vector, len);
+    long_column_writer->flush();
+    auto statistic = long_column_writer->getColumnChunkStat();
+    EXPECT_EQ(statistic.numberofvalues(), len);
+    EXPECT_FALSE(statistic.hasnull());
+    EXPECT_EQ(statistic.intstatistics().minimum(), 0);
+    EXPECT_EQ(statistic.intstatistics().maximum(), len - 1);
+    EXPECT_EQ(statistic.intstatistics().sum(), len * (len - 1) / 2);
+    auto chunk_index = long_column_writer->getColumnChunkIndexPtr();
+    ASSERT_EQ(chunk_index->pixelstatistics_size(), 3);
+    EXPECT_EQ(chunk_index->pixelstatistics(1).statistic().intstatistics().minimum(),
+              pixel_stride);
+    EXPECT_EQ(chunk_index->pixelstatistics(1).statistic().intstatistics().maximum(),
+              2 * pixel_stride - 1);
+
+    // the second row group, written by the reset writer
+    long_column_writer->reset();
+    long_column_vector =
+        std::make_shared<LongColumnVector>(len, encoding, is_long);
+    for (int i = 0; i < len; ++i) {
+        if (i % 4 == 0) {
+            long_column_vector->addNull();
+        } else {
+            long_column_vector->add(1000 + i);
+        }
+    }
+    long_column_writer->write(long_column_vector, len);
+    long_column_writer->flush();
+    statistic = long_column_writer->getColumnChunkStat();
+    EXPECT_EQ(statistic.numberofvalues(), len);
+    EXPECT_TRUE(statistic.hasnull());
+    EXPECT_EQ(statistic.intstatistics().minimum(), 1001);
+    EXPECT_EQ(statistic.intstatistics().maximum(), 1000 + len - 1);
+    long sum = 0;
+    for (int i = 0; i < len; ++i) {
+        sum += i % 4 == 0 ? 0 : 1000 + i;
+    }
+    EXPECT_EQ(statistic.intstatistics().sum(), sum);
+    ASSERT_EQ(chunk_index->pixelstatistics_size(), 3);
+    EXPECT_TRUE(chunk_index->pixelstatistics(0).statistic().hasnull());
+    EXPECT_EQ(chunk_index->pixelstatistics(0).statistic().intstatistics().minimum(),
+              1001);
+    long_column_writer->close();
+}
@@ -0,0 +1,175 @@
+/*
+ * Copyright 2024 PixelsDB.
+ *
+ * This file is part of Pixels.
+ *
+ * Pixels is free software: you can redistribute it and/or modify
+ * it under the terms of the Affero GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Pixels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Affero GNU General Public License for more details.
+ *
+ * You should have received a copy of the Affero GNU General Public
+ * License along with Pixels.  If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+#include "reader/StringColumnReader.h"
+#include "vector/BinaryColumnVector.h"
+#include "writer/StringColumnWriter.h"
+#include "ColumnWriterTestUtil.h"
+
+#include "gtest/gtest.h"
+#include <optional>
+#include <string>
+#include <vector>
+
+/**
+ * Write the values (a null for each std::nullopt) with a StringColumnWriter, read them back
+ * pixel by pixel with a StringColumnReader and check them.
+ * @return the encoding of the written column chunk
+ */
+static pixels::proto::ColumnEncoding
+checkStringRoundTrip(const std::vector<std::optional<std::string>> &values,
+                     int pixel_stride, EncodingLevel::Level encoding_level) {
+    int len = values.size();
+    std::vector<bool> nulls(len);
+    auto string_column_vector = std::make_shared<BinaryColumnVector>(len);
+    for (int i = 0; i < len; ++i) {
+        nulls[i] = !values[i];
+        if (values[i]) {
+            // setRef only keeps a view, values outlives the writer
+            auto data = reinterpret_cast<uint8_t *>(
+                const_cast<char *>(values[i]->data()));
+            string_column_vector->setRef(i, data, 0, values[i]->size());
+        } else {
+            string_column_vector->addNull();
+        }
+    }
+
+    auto option = std::make_shared<PixelsWriterOption>();
+    option->setPixelsStride(pixel_stride);
+    option->setNullsPadding(true);
+    option->setEncodingLevel(EncodingLevel(encoding_level));
+
+    StringColumnWriter writer(TypeDescription::createString(), option);
+    StringColumnReader reader(TypeDescription::createString());
+    return checkRoundTrip<BinaryColumnVector>(
+        writer, reader, string_column_vector, nulls, pixel_stride,
+        [&](const pixels::proto::ColumnEncoding &) {
+            return std::make_shared<BinaryColumnVector>(len);
+        },
+        [&](BinaryColumnVector &result, int row, int index) {
+            const auto &actual = result.vector[index];
+            EXPECT_EQ(std::string(actual.GetData(), actual.GetSize()), *values[row])
+                << "at row " << row;
+        });
+}
+
+static std::string makeValue(int i) {
+    // longer than the inlined strings of duckdb::string_t
+    return "pixels-string-value-" + std::to_string(i);
+}
+
+TEST(StringWriterTest, WriteDictionaryWithRunLength) {
+    int len = 256;
+    int pixel_stride = 64;
+    std::vector<std::optional<std::string>> values;
+    for (int i = 0; i < len; ++i) {
+        values.emplace_back(makeValue(i / 3 % 4));
+    }
+    auto encoding = checkStringRoundTrip(values, pixel_stride, EncodingLevel::EL2);
+    EXPECT_EQ(encoding.kind(), pixels::proto::ColumnEncoding_Kind_DICTIONARY);
+    EXPECT_EQ(encoding.dictionarysize(), 4);
+    ASSERT_TRUE(encoding.has_cascadeencoding());
+    EXPECT_EQ(encoding.cascadeencoding().kind(),
+              pixels::proto::ColumnEncoding_Kind_RUNLENGTH);
+}
+
+TEST(StringWriterTest, WriteDictionaryWithoutRunLength) {
+    int len = 256;
+    int pixel_stride = 64;
+    std::vector<std::optional<std::string>> values;
+    for (int i = 0; i < len; ++i) {
+        values.emplace_back(makeValue(i / 3 % 4));
+    }
+    auto encoding = checkStringRoundTrip(values, pixel_stride, EncodingLevel::EL1);
+    EXPECT_EQ(encoding.kind(), pixels::proto::ColumnEncoding_Kind_DICTIONARY);
+    EXPECT_EQ(encoding.dictionarysize(), 4);
+    EXPECT_FALSE(encoding.has_cascadeencoding());
+}
+
+TEST(StringWriterTest, WritePlainAboveDictionaryThreshold) {
+    int len = 256;
+    int pixel_stride = 64;
+    std::vector<std::optional<std::string>> values;
+    for (int i = 0; i < len; ++i) {
+        values.emplace_back(makeValue(i));
+    }
+    // every value of the first pixel is distinct, above pixel.writer.dictionary.threshold
+    auto encoding = checkStringRoundTrip(values, pixel_stride, EncodingLevel::EL2);
+    EXPECT_EQ(encoding.kind(), pixels::proto::ColumnEncoding_Kind_NONE);
+}
+
+TEST(StringWriterTest, WritePlainWithoutDictionary) {
+    int len = 256;
+    int pixel_stride = 64;
+    std::vector<std::optional<std::string>> values;
+    for (int i = 0; i < len; ++i) {
+        values.emplace_back(makeValue(i % 4));
+    }
+    auto encoding = checkStringRoundTrip(values, pixel_stride, EncodingLevel::EL0);
+    EXPECT_EQ(encoding.kind(), pixels::proto::ColumnEncoding_Kind_NONE);
+}
+
+TEST(StringWriterTest, WriteDictionaryWithNull) {
+    int len = 250;
+    int pixel_stride = 64;
+    std::vector<std::optional<std::string>> values;
+    for (int i = 0; i < len; ++i) {
+        if (i % 3 == 0) {
+            values.emplace_back(std::nullopt);
+        } else {
+            values.emplace_back(makeValue(i % 4));
+        }
+    }
+    auto encoding = checkStringRoundTrip(values, pixel_stride, EncodingLevel::EL2);
+    EXPECT_EQ(encoding.kind(), pixels::proto::ColumnEncoding_Kind_DICTIONARY);
+    encoding = checkStringRoundTrip(values, pixel_stride, EncodingLevel::EL1);
+    EXPECT_EQ(encoding.kind(), pixels::proto::ColumnEncoding_Kind_DICTIONARY);
+}
+
+TEST(StringWriterTest, WritePlainWithNull) {
+    int len = 250;
+    int pixel_stride = 64;
+    std::vector<std::optional<std::string>> values;
+    for (int i = 0; i < len; ++i) {
+        if (i % 3 == 0) {
+            values.emplace_back(std::nullopt);
+        } else {
+            values.emplace_back(makeValue(i));
+        }
+    }
+    auto encoding = checkStringRoundTrip(values, pixel_stride, EncodingLevel::EL2);
+    EXPECT_EQ(encoding.kind(), pixels::proto::ColumnEncoding_Kind_NONE);
+}
+
+TEST(StringWriterTest, WriteAllNullFirstPixel) {
+    int len = 256;
+    int pixel_stride = 64;
+    std::vector<std::optional<std::string>> values;
+    for (int i = 0; i < len; ++i) {
+        if (i < pixel_stride) {
+            values.emplace_back(std::nullopt);
+        } else {
+            values.emplace_back(makeValue(i % 4));
+        }
+    }
+    // the first pixel has no value to build the dictionary from
+    auto encoding = checkStringRoundTrip(values, pixel_stride, EncodingLevel::EL2);
+    EXPECT_EQ(encoding.kind(), pixels::proto::ColumnEncoding_Kind_NONE);
+}